@@ -0,0 +1,302 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+#include <future>
+
+using namespace std;
+using namespace seal;
+
+namespace
+{
+    /*
+    레지스트리는 직렬화된 EncryptionParameters를 키로 사용합니다. 같은 scheme, poly_modulus_degree,
+    coeff_modulus, plain_modulus를 가진 매개변수는 같은 바이트열로 직렬화되므로 같은 세션을 공유합니다.
+    */
+    string session_key(const EncryptionParameters &parms)
+    {
+        stringstream stream;
+        parms.save(stream, compr_mode_type::none);
+        return stream.str();
+    }
+
+    /*
+    레지스트리의 항목은 세션 자체가 아니라 세션이 만들어지면 준비되는 shared_future입니다. ticket은 항목을 만든
+    호출을 구별하며, 생성이 실패했을 때 그 사이 Clear()와 다른 호출이 새로 넣은 항목을 지우지 않도록 합니다.
+    */
+    struct RegistryEntry
+    {
+        uint64_t ticket;
+        shared_future<shared_ptr<SEALSession>> session;
+    };
+
+    mutex &registry_mutex()
+    {
+        static mutex registry_mutex;
+        return registry_mutex;
+    }
+
+    map<string, RegistryEntry> &registry()
+    {
+        static map<string, RegistryEntry> registry;
+        return registry;
+    }
+} // namespace
+
+shared_ptr<SEALSession> SEALSession::Get(const EncryptionParameters &parms)
+{
+    static uint64_t next_ticket = 0;
+    string key = session_key(parms);
+
+    /*
+    잠금 안에서는 자리만 차지합니다. SEALContext 생성(소수 검증, NTT 테이블 계산)은 잠금 밖에서 자리를 차지한
+    호출자 하나만 수행하므로, 다른 매개변수를 요청하는 스레드는 기다리지 않고, 같은 매개변수로 동시에 들어온
+    호출자는 그 결과를 기다렸다가 같은 세션을 받습니다.
+    */
+    promise<shared_ptr<SEALSession>> session_promise;
+    shared_future<shared_ptr<SEALSession>> session;
+    uint64_t ticket = 0;
+    bool create = false;
+    {
+        lock_guard<mutex> lock(registry_mutex());
+        auto &sessions = registry();
+        auto it = sessions.find(key);
+        if (it != sessions.end())
+        {
+            session = it->second.session;
+        }
+        else
+        {
+            ticket = next_ticket++;
+            session = session_promise.get_future().share();
+            sessions.emplace(key, RegistryEntry{ ticket, session });
+            create = true;
+        }
+    }
+
+    if (create)
+    {
+        try
+        {
+            session_promise.set_value(make_shared<SEALSession>(parms));
+        }
+        catch (...)
+        {
+            /*
+            실패한 항목은 지워서 다음 호출이 다시 시도할 수 있게 합니다. 기다리던 호출자들은 같은 예외를 받습니다.
+            */
+            {
+                lock_guard<mutex> lock(registry_mutex());
+                auto &sessions = registry();
+                auto it = sessions.find(key);
+                if (it != sessions.end() && it->second.ticket == ticket)
+                {
+                    sessions.erase(it);
+                }
+            }
+            session_promise.set_exception(current_exception());
+        }
+    }
+    return session.get();
+}
+
+void SEALSession::Clear()
+{
+    lock_guard<mutex> lock(registry_mutex());
+    registry().clear();
+}
+
+size_t SEALSession::Count()
+{
+    lock_guard<mutex> lock(registry_mutex());
+    return registry().size();
+}
+
+SEALSession::SEALSession(const EncryptionParameters &parms) : context_(parms)
+{
+    if (!context_.parameters_set())
+    {
+        throw invalid_argument("encryption parameters are not valid: " + string(context_.parameter_error_message()));
+    }
+}
+
+const TracedEvaluator &SEALSession::evaluator()
+{
+    call_once(evaluator_flag_, [this]() { evaluator_ = make_unique<TracedEvaluator>(context_); });
+    return *evaluator_;
+}
+
+const TracedCKKSEncoder &SEALSession::ckks_encoder()
+{
+    call_once(ckks_encoder_flag_, [this]() { ckks_encoder_ = make_unique<TracedCKKSEncoder>(context_); });
+    return *ckks_encoder_;
+}
+
+const TracedBatchEncoder &SEALSession::batch_encoder()
+{
+    call_once(batch_encoder_flag_, [this]() { batch_encoder_ = make_unique<TracedBatchEncoder>(context_); });
+    return *batch_encoder_;
+}
+
+KeyGenerator &SEALSession::keygen()
+{
+    call_once(keygen_flag_, [this]() {
+        TRACE_SCOPE("create_secret_key");
+        keygen_ = make_unique<KeyGenerator>(context_);
+    });
+    return *keygen_;
+}
+
+const SecretKey &SEALSession::secret_key()
+{
+    return keygen().secret_key();
+}
+
+const PublicKey &SEALSession::public_key()
+{
+    call_once(public_key_flag_, [this]() {
+        TRACE_SCOPE("create_public_key");
+        keygen().create_public_key(public_key_);
+    });
+    return public_key_;
+}
+
+const RelinKeys &SEALSession::relin_keys()
+{
+    call_once(relin_keys_flag_, [this]() {
+        TRACE_SCOPE("create_relin_keys");
+        keygen().create_relin_keys(relin_keys_);
+    });
+    return relin_keys_;
+}
+
+const GaloisKeys &SEALSession::galois_keys()
+{
+    call_once(galois_keys_flag_, [this]() {
+        TRACE_SCOPE("create_galois_keys");
+        keygen().create_galois_keys(galois_keys_);
+    });
+    return galois_keys_;
+}
+
+const GaloisKeys &SEALSession::galois_keys(vector<int> steps)
+{
+    sort(steps.begin(), steps.end());
+    steps.erase(unique(steps.begin(), steps.end()), steps.end());
+    steps.erase(remove(steps.begin(), steps.end(), 0), steps.end());
+
+    lock_guard<mutex> lock(step_galois_keys_mutex_);
+    auto it = step_galois_keys_.find(steps);
+    if (it == step_galois_keys_.end())
+    {
+        TRACE_SCOPE("create_galois_keys");
+        GaloisKeys keys;
+        keygen().create_galois_keys(steps, keys);
+        it = step_galois_keys_.emplace(move(steps), move(keys)).first;
+    }
+    return it->second;
+}
+
+const TracedEncryptor &SEALSession::encryptor()
+{
+    call_once(encryptor_flag_, [this]() { encryptor_ = make_unique<TracedEncryptor>(context_, public_key()); });
+    return *encryptor_;
+}
+
+TracedDecryptor &SEALSession::decryptor()
+{
+    call_once(decryptor_flag_, [this]() { decryptor_ = make_unique<TracedDecryptor>(context_, secret_key()); });
+    return *decryptor_;
+}
+
+/*
+같은 매개변수로 작업을 여러 번 반복할 때 세션 레지스트리가 설정 비용을 한 번만 지불하게 해 주는지 확인합니다.
+*/
+void example_session()
+{
+    print_example_banner("Example: Session Registry");
+
+    EncryptionParameters parms(scheme_type::ckks);
+    size_t poly_modulus_degree = 16384;
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, 50, 50, 50, 50, 60 }));
+    double scale = pow(2.0, 50);
+
+    chrono::high_resolution_clock::time_point time_start, time_end;
+
+    /*
+    같은 작업(인코딩 -> 암호화 -> 제곱 -> 회전 -> 복호화)을 세 번 실행합니다. 첫 번째 실행만 컨텍스트와 키를
+    만들고, 이후의 실행은 레지스트리에서 같은 세션을 돌려받습니다.
+    */
+    for (int run = 1; run <= 3; run++)
+    {
+        print_line(__LINE__);
+        cout << "Run " << run << ":" << endl;
+
+        time_start = chrono::high_resolution_clock::now();
+        auto session = SEALSession::Get(parms);
+        auto &encoder = session->ckks_encoder();
+        auto &evaluator = session->evaluator();
+        auto &relin_keys = session->relin_keys();
+        auto &galois_keys = session->galois_keys();
+        auto &encryptor = session->encryptor();
+        auto &decryptor = session->decryptor();
+        time_end = chrono::high_resolution_clock::now();
+        auto time_setup = chrono::duration_cast<chrono::microseconds>(time_end - time_start);
+
+        if (run == 1)
+        {
+            print_parameters(session->context());
+        }
+
+        time_start = chrono::high_resolution_clock::now();
+        vector<double> input(encoder.slot_count());
+        for (size_t i = 0; i < input.size(); i++)
+        {
+            input[i] = static_cast<double>(i) / static_cast<double>(input.size() - 1);
+        }
+        Plaintext plain;
+        encoder.encode(input, scale, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+        evaluator.square_inplace(encrypted);
+        evaluator.relinearize_inplace(encrypted, relin_keys);
+        evaluator.rescale_to_next_inplace(encrypted);
+        evaluator.rotate_vector_inplace(encrypted, 1, galois_keys);
+        decryptor.decrypt(encrypted, plain);
+        vector<double> result;
+        encoder.decode(plain, result);
+        time_end = chrono::high_resolution_clock::now();
+        auto time_work = chrono::duration_cast<chrono::microseconds>(time_end - time_start);
+
+        cout << "    + Setup (context, encoder, evaluator, keys): " << time_setup.count() << " microseconds" << endl;
+        cout << "    + Work (encode, encrypt, square, rotate, decrypt): " << time_work.count() << " microseconds"
+             << endl;
+        cout << "    + Sessions in registry: " << SEALSession::Count() << endl;
+        print_vector(result, 3, 7);
+    }
+
+    /*
+    여러 스레드가 같은 매개변수로 동시에 세션을 요청해도 컨텍스트와 키는 한 번만 만들어집니다.
+    */
+    size_t thread_count = max<size_t>(1, thread::hardware_concurrency());
+    print_line(__LINE__);
+    cout << "Request the same session from " << thread_count << " threads." << endl;
+    vector<SEALSession *> seen(thread_count, nullptr);
+    vector<thread> threads;
+    for (size_t t = 0; t < thread_count; t++)
+    {
+        threads.emplace_back([&parms, &seen, t]() {
+            auto session = SEALSession::Get(parms);
+            session->relin_keys();
+            seen[t] = session.get();
+        });
+    }
+    for (auto &th : threads)
+    {
+        th.join();
+    }
+    bool shared = all_of(seen.begin(), seen.end(), [&seen](SEALSession *s) { return s == seen[0]; });
+    cout << "    + All threads share one session: " << (shared ? "yes" : "no") << endl;
+    cout << "    + Sessions in registry: " << SEALSession::Count() << endl;
+}
@@ -0,0 +1,263 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+#include <complex>
+
+using namespace std;
+using namespace seal;
+
+/*
+CKKS의 슬롯은 복소수이지만 지금까지의 예제는 vector<double>만 인코딩하므로 각 슬롯의 허수부는 항상 0입니다.
+두 개의 실수 벡터 a, b를 z = a + i*b 형태로 하나의 암호문에 담으면 선형 연산(덧셈, 뺄셈, 실수 상수 곱,
+회전)은 두 벡터에 동시에 적용됩니다. 암호문과 연산 수가 절반으로 줄어듭니다.
+
+곱셈처럼 실수부와 허수부를 섞는 연산이 필요할 때는 complex conjugate(z의 켤레 z*)를 사용하여 두 벡터를
+분리합니다.
+
+    a = (z + z*) / 2,        b = (z - z*) / (2i)
+
+a와 b에 서로 다른 실수 가중치 wa, wb를 곱해야 하는 경우에도 켤레를 사용합니다.
+
+    z * (wa + wb) / 2 + z* * (wa - wb) / 2 = wa*a + i*wb*b
+*/
+namespace
+{
+    vector<complex<double>> pack_pair(const vector<double> &a, const vector<double> &b)
+    {
+        if (a.size() != b.size())
+        {
+            throw invalid_argument("a and b must have the same size");
+        }
+        vector<complex<double>> packed(a.size());
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            packed[i] = complex<double>(a[i], b[i]);
+        }
+        return packed;
+    }
+
+    void unpack_pair(const vector<complex<double>> &packed, vector<double> &a, vector<double> &b)
+    {
+        a.resize(packed.size());
+        b.resize(packed.size());
+        for (size_t i = 0; i < packed.size(); i++)
+        {
+            a[i] = packed[i].real();
+            b[i] = packed[i].imag();
+        }
+    }
+
+    /*
+    z = a + i*b에 a와 b 각각 다른 실수 가중치를 곱합니다. 결과는 wa*a + i*wb*b이며 레벨을 하나 소비합니다.
+    */
+    void multiply_pair_plain(
+        const TracedEvaluator &evaluator, const TracedCKKSEncoder &encoder, const GaloisKeys &galois_keys,
+        Ciphertext &packed, const vector<double> &wa, const vector<double> &wb, double scale)
+    {
+        vector<double> u(wa.size()), v(wa.size());
+        for (size_t i = 0; i < wa.size(); i++)
+        {
+            u[i] = (wa[i] + wb[i]) / 2;
+            v[i] = (wa[i] - wb[i]) / 2;
+        }
+        Plaintext plain_u, plain_v;
+        encoder.encode(u, packed.parms_id(), scale, plain_u);
+        encoder.encode(v, packed.parms_id(), scale, plain_v);
+
+        Ciphertext conj;
+        evaluator.complex_conjugate(packed, galois_keys, conj);
+        evaluator.multiply_plain_inplace(packed, plain_u);
+        evaluator.multiply_plain_inplace(conj, plain_v);
+        evaluator.add_inplace(packed, conj);
+        evaluator.rescale_to_next_inplace(packed);
+    }
+
+    /*
+    z = a + i*b를 실수부 a와 허수부 b를 담은 두 개의 암호문으로 분리합니다. 두 결과 모두 레벨을 하나 소비합니다.
+    */
+    void separate_pair(
+        const TracedEvaluator &evaluator, const TracedCKKSEncoder &encoder, const GaloisKeys &galois_keys,
+        const Ciphertext &packed, Ciphertext &real_part, Ciphertext &imag_part, double scale)
+    {
+        Ciphertext conj;
+        evaluator.complex_conjugate(packed, galois_keys, conj);
+
+        Plaintext half, minus_half_i;
+        encoder.encode(complex<double>(0.5, 0.0), packed.parms_id(), scale, half);
+        encoder.encode(complex<double>(0.0, -0.5), packed.parms_id(), scale, minus_half_i);
+
+        evaluator.add(packed, conj, real_part);
+        evaluator.multiply_plain_inplace(real_part, half);
+        evaluator.rescale_to_next_inplace(real_part);
+
+        evaluator.sub(packed, conj, imag_part);
+        evaluator.multiply_plain_inplace(imag_part, minus_half_i);
+        evaluator.rescale_to_next_inplace(imag_part);
+    }
+
+    /*
+    예제에서 사용하는 선형 파이프라인입니다: 2*x + rotate(x, 1) + rotate(x, 2) - rotate(x, 4).
+    상수 2는 덧셈으로 구현하여 레벨을 소비하지 않습니다.
+    */
+    void linear_pipeline(const TracedEvaluator &evaluator, const GaloisKeys &galois_keys, Ciphertext &encrypted)
+    {
+        Ciphertext r1, r2, r4;
+        evaluator.rotate_vector(encrypted, 1, galois_keys, r1);
+        evaluator.rotate_vector(encrypted, 2, galois_keys, r2);
+        evaluator.rotate_vector(encrypted, 4, galois_keys, r4);
+        evaluator.add_inplace(encrypted, encrypted);
+        evaluator.add_inplace(encrypted, r1);
+        evaluator.add_inplace(encrypted, r2);
+        evaluator.sub_inplace(encrypted, r4);
+    }
+
+    double linear_pipeline_reference(const vector<double> &x, size_t i)
+    {
+        size_t n = x.size();
+        return 2 * x[i] + x[(i + 1) % n] + x[(i + 2) % n] - x[(i + 4) % n];
+    }
+} // namespace
+
+void example_complex_packing()
+{
+    print_example_banner("Example: Complex-Slot Packing");
+
+    EncryptionParameters parms(scheme_type::ckks);
+    size_t poly_modulus_degree = 16384;
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, 50, 50, 50, 50, 60 }));
+    double scale = pow(2.0, 50);
+
+    auto session = SEALSession::Get(parms);
+    print_parameters(session->context());
+    cout << endl;
+
+    auto &encoder = session->ckks_encoder();
+    auto &evaluator = session->evaluator();
+    auto &galois_keys = session->galois_keys();
+    auto &encryptor = session->encryptor();
+    auto &decryptor = session->decryptor();
+    size_t slot_count = encoder.slot_count();
+
+    /*
+    두 개의 실수 입력 벡터를 만듭니다.
+    */
+    vector<double> a(slot_count), b(slot_count);
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        double t = static_cast<double>(i) / static_cast<double>(slot_count - 1);
+        a[i] = t;
+        b[i] = 1.0 - t * t;
+    }
+    cout << "Input vector a: " << endl;
+    print_vector(a, 3, 7);
+    cout << "Input vector b: " << endl;
+    print_vector(b, 3, 7);
+
+    vector<double> expected_a(slot_count), expected_b(slot_count);
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        expected_a[i] = linear_pipeline_reference(a, i);
+        expected_b[i] = linear_pipeline_reference(b, i);
+    }
+
+    chrono::high_resolution_clock::time_point time_start, time_end;
+
+    /*
+    기준: a와 b를 각각의 암호문으로 암호화하고 같은 파이프라인을 두 번 실행합니다.
+    */
+    print_line(__LINE__);
+    cout << "Baseline: two ciphertexts, pipeline evaluated twice." << endl;
+    time_start = chrono::high_resolution_clock::now();
+    Plaintext plain_a, plain_b;
+    encoder.encode(a, scale, plain_a);
+    encoder.encode(b, scale, plain_b);
+    Ciphertext encrypted_a, encrypted_b;
+    encryptor.encrypt(plain_a, encrypted_a);
+    encryptor.encrypt(plain_b, encrypted_b);
+    linear_pipeline(evaluator, galois_keys, encrypted_a);
+    linear_pipeline(evaluator, galois_keys, encrypted_b);
+    time_end = chrono::high_resolution_clock::now();
+    auto time_separate = chrono::duration_cast<chrono::microseconds>(time_end - time_start);
+
+    vector<double> result_a, result_b;
+    Plaintext plain_result;
+    decryptor.decrypt(encrypted_a, plain_result);
+    encoder.decode(plain_result, result_a);
+    decryptor.decrypt(encrypted_b, plain_result);
+    encoder.decode(plain_result, result_b);
+    cout << "    + Ciphertexts: 2, rotations: 6" << endl;
+    cout << "    + Encode, encrypt and evaluate: " << time_separate.count() << " microseconds" << endl;
+    cout << "    + Max error: " << max(max_abs_error(expected_a, result_a), max_abs_error(expected_b, result_b))
+         << endl;
+
+    /*
+    복소수 패킹: z = a + i*b를 하나의 암호문으로 암호화하고 파이프라인을 한 번만 실행합니다.
+    회전과 덧셈은 실수부와 허수부에 똑같이 적용되므로 결과의 실수부는 a, 허수부는 b에 대한 결과입니다.
+    */
+    print_line(__LINE__);
+    cout << "Packed: one ciphertext holding a + i*b, pipeline evaluated once." << endl;
+    time_start = chrono::high_resolution_clock::now();
+    Plaintext plain_packed;
+    encoder.encode(pack_pair(a, b), scale, plain_packed);
+    Ciphertext encrypted_packed;
+    encryptor.encrypt(plain_packed, encrypted_packed);
+    linear_pipeline(evaluator, galois_keys, encrypted_packed);
+    time_end = chrono::high_resolution_clock::now();
+    auto time_packed = chrono::duration_cast<chrono::microseconds>(time_end - time_start);
+
+    vector<complex<double>> packed_result;
+    decryptor.decrypt(encrypted_packed, plain_result);
+    encoder.decode(plain_result, packed_result);
+    unpack_pair(packed_result, result_a, result_b);
+    cout << "    + Ciphertexts: 1, rotations: 3" << endl;
+    cout << "    + Encode, encrypt and evaluate: " << time_packed.count() << " microseconds" << endl;
+    cout << "    + Max error: " << max(max_abs_error(expected_a, result_a), max_abs_error(expected_b, result_b))
+         << endl;
+    cout << "    + Real part (a):" << endl;
+    print_vector(result_a, 3, 7);
+    cout << "    + Imaginary part (b):" << endl;
+    print_vector(result_b, 3, 7);
+
+    /*
+    a와 b에 서로 다른 가중치를 곱합니다: 0.5*a와 3*b.
+    */
+    print_line(__LINE__);
+    cout << "Apply different real weights to a (0.5) and b (3.0) with one conjugation." << endl;
+    Ciphertext weighted = encrypted_packed;
+    multiply_pair_plain(
+        evaluator, encoder, galois_keys, weighted, vector<double>(slot_count, 0.5), vector<double>(slot_count, 3.0),
+        scale);
+    decryptor.decrypt(weighted, plain_result);
+    encoder.decode(plain_result, packed_result);
+    unpack_pair(packed_result, result_a, result_b);
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        expected_a[i] = 0.5 * linear_pipeline_reference(a, i);
+        expected_b[i] = 3.0 * linear_pipeline_reference(b, i);
+    }
+    cout << "    + Max error: " << max(max_abs_error(expected_a, result_a), max_abs_error(expected_b, result_b))
+         << endl;
+
+    /*
+    마지막으로 켤레를 이용하여 두 벡터를 별도의 암호문으로 분리합니다. 분리된 암호문은 일반적인 실수 암호문과
+    같으므로 곱셈 등 비선형 연산을 계속할 수 있습니다.
+    */
+    print_line(__LINE__);
+    cout << "Separate real and imaginary parts with complex_conjugate." << endl;
+    Ciphertext real_part, imag_part;
+    separate_pair(evaluator, encoder, galois_keys, encrypted_packed, real_part, imag_part, scale);
+    decryptor.decrypt(real_part, plain_result);
+    encoder.decode(plain_result, result_a);
+    decryptor.decrypt(imag_part, plain_result);
+    encoder.decode(plain_result, result_b);
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        expected_a[i] = linear_pipeline_reference(a, i);
+        expected_b[i] = linear_pipeline_reference(b, i);
+    }
+    cout << "    + Max error in a: " << max_abs_error(expected_a, result_a) << endl;
+    cout << "    + Max error in b: " << max_abs_error(expected_b, result_b) << endl;
+    print_vector(result_b, 3, 7);
+}
@@ -0,0 +1,367 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+
+using namespace std;
+using namespace seal;
+
+/*
+암호화된 시계열에 대한 1차원 컨볼루션(stencil) 커널입니다. 시계열 전체를 CKKS 슬롯에 담으면 각 출력 슬롯
+
+    y[i] = w_0 * x[i + o_0] + w_1 * x[i + o_1] + ... + w_{K-1} * x[i + o_{K-1}]
+
+은 rotate_vector와 multiply_plain만으로 계산되며, 슬롯 벡터 위의 모든 윈도우가 한꺼번에 처리됩니다.
+회전은 순환적이므로 마지막 (o_max - o_min)개의 출력 슬롯은 벡터의 시작 부분과 섞입니다.
+
+6_rotation.cpp 방식으로 탭마다 회전, 곱셈, rescale을 반복하면 K번의 회전(전체 Galois 키에서는 단계마다 여러 번의
+key switching), K번의 rescale이 필요합니다. 여기서는 다음과 같이 비용을 줄입니다.
+
+    - 탭 가중치 평문은 커널을 만들 때 한 번만 인코딩합니다.
+    - 오프셋을 d = g*j + i (baby step i, giant step j)로 나누면 가중치가 스칼라이므로
+          y = rot(sum_j rot(sum_i w_{g*j+i} * rot(x, i), g*j), o_min)
+      이 되어 회전 횟수가 K - 1에서 약 2*sqrt(K)로 줄어듭니다. baby step 회전 rot(x, i)는 입력 하나에서
+      모든 giant step이 공유합니다(SEAL은 hoisting을 공개 API로 제공하지 않으므로 이것이 그 대안입니다).
+    - 필요한 단계에 대해서만 Galois 키를 만들어 회전 하나가 key switching 한 번으로 끝나게 합니다.
+    - 모든 곱을 2^100 스케일에서 더한 뒤 rescale은 한 번만 수행합니다.
+*/
+namespace
+{
+    struct Tap
+    {
+        int offset;
+        double weight;
+    };
+
+    class ConvolutionKernel
+    {
+    public:
+        ConvolutionKernel(SEALSession &session, vector<Tap> taps, parms_id_type parms_id, double scale)
+            : session_(session)
+        {
+            /*
+            같은 오프셋의 탭은 가중치를 더해 하나로 합치고, 가중치가 0인 탭은 버립니다. 두 탭이 같은 격자 위치에
+            인코딩되면 뒤의 것이 앞의 것을 덮어쓰며, 0으로 인코딩된 평문과의 multiply_plain은 transparent 암호문
+            때문에 예외를 던지기 때문입니다. apply_tap_by_tap()과 reference()도 합쳐진 taps_를 사용합니다.
+            */
+            sort(taps.begin(), taps.end(), [](const Tap &a, const Tap &b) { return a.offset < b.offset; });
+            for (auto &tap : taps)
+            {
+                if (!taps_.empty() && taps_.back().offset == tap.offset)
+                {
+                    taps_.back().weight += tap.weight;
+                }
+                else
+                {
+                    taps_.push_back(tap);
+                }
+            }
+            taps_.erase(
+                remove_if(taps_.begin(), taps_.end(), [](const Tap &tap) { return tap.weight == 0.0; }), taps_.end());
+            if (taps_.empty())
+            {
+                throw invalid_argument("kernel must have at least one non-zero tap");
+            }
+            min_offset_ = taps_.front().offset;
+            int span = taps_.back().offset - min_offset_ + 1;
+            baby_steps_ = max(1, static_cast<int>(ceil(sqrt(static_cast<double>(span)))));
+            giant_steps_ = (span + baby_steps_ - 1) / baby_steps_;
+
+            /*
+            가중치를 (giant step, baby step) 격자에 배치하고 평문으로 미리 인코딩합니다.
+            */
+            auto &encoder = session_.ckks_encoder();
+            weights_.assign(static_cast<size_t>(giant_steps_), vector<Plaintext>(static_cast<size_t>(baby_steps_)));
+            present_.assign(static_cast<size_t>(giant_steps_), vector<bool>(static_cast<size_t>(baby_steps_), false));
+            for (auto &tap : taps_)
+            {
+                int d = tap.offset - min_offset_;
+                size_t j = static_cast<size_t>(d / baby_steps_);
+                size_t i = static_cast<size_t>(d % baby_steps_);
+                encoder.encode(tap.weight, parms_id, scale, weights_[j][i]);
+                present_[j][i] = true;
+            }
+
+            vector<int> steps;
+            for (int i = 1; i < baby_steps_; i++)
+            {
+                steps.push_back(i);
+            }
+            if (giant_steps_ > 1)
+            {
+                steps.push_back(baby_steps_);
+            }
+            steps.push_back(min_offset_);
+            galois_keys_ = &session_.galois_keys(steps);
+        }
+
+        size_t rotation_count() const
+        {
+            return static_cast<size_t>(baby_steps_ - 1 + giant_steps_ - 1 + (min_offset_ != 0 ? 1 : 0));
+        }
+
+        void apply(const Ciphertext &encrypted, Ciphertext &destination) const
+        {
+            auto &evaluator = session_.evaluator();
+
+            vector<Ciphertext> baby(static_cast<size_t>(baby_steps_));
+            baby[0] = encrypted;
+            for (int i = 1; i < baby_steps_; i++)
+            {
+                evaluator.rotate_vector(encrypted, i, *galois_keys_, baby[static_cast<size_t>(i)]);
+            }
+
+            bool have_result = false;
+            Ciphertext term;
+            for (int j = giant_steps_ - 1; j >= 0; j--)
+            {
+                bool have_inner = false;
+                Ciphertext inner;
+                for (size_t i = 0; i < baby.size(); i++)
+                {
+                    if (!present_[static_cast<size_t>(j)][i])
+                    {
+                        continue;
+                    }
+                    evaluator.multiply_plain(baby[i], weights_[static_cast<size_t>(j)][i], term);
+                    if (have_inner)
+                    {
+                        evaluator.add_inplace(inner, term);
+                    }
+                    else
+                    {
+                        inner = move(term);
+                        have_inner = true;
+                    }
+                }
+
+                /*
+                Horner 방식으로 giant step을 누적합니다: result = rot(result, g) + inner_j.
+                이렇게 하면 giant step 회전은 모두 같은 단계 g만 사용합니다.
+                */
+                if (have_result)
+                {
+                    evaluator.rotate_vector_inplace(destination, baby_steps_, *galois_keys_);
+                    if (have_inner)
+                    {
+                        evaluator.add_inplace(destination, inner);
+                    }
+                }
+                else if (have_inner)
+                {
+                    destination = move(inner);
+                    have_result = true;
+                }
+            }
+
+            evaluator.rescale_to_next_inplace(destination);
+            if (min_offset_ != 0)
+            {
+                evaluator.rotate_vector_inplace(destination, min_offset_, *galois_keys_);
+            }
+        }
+
+        /*
+        6_rotation.cpp 방식의 탭 단위 구현입니다. 비교용으로만 사용합니다.
+        */
+        void apply_tap_by_tap(const Ciphertext &encrypted, Ciphertext &destination, double scale) const
+        {
+            auto &evaluator = session_.evaluator();
+            auto &encoder = session_.ckks_encoder();
+            auto &galois_keys = session_.galois_keys();
+
+            for (size_t k = 0; k < taps_.size(); k++)
+            {
+                Ciphertext rotated;
+                if (taps_[k].offset != 0)
+                {
+                    evaluator.rotate_vector(encrypted, taps_[k].offset, galois_keys, rotated);
+                }
+                else
+                {
+                    rotated = encrypted;
+                }
+                Plaintext plain_weight;
+                encoder.encode(taps_[k].weight, rotated.parms_id(), scale, plain_weight);
+                evaluator.multiply_plain_inplace(rotated, plain_weight);
+                evaluator.rescale_to_next_inplace(rotated);
+                if (k == 0)
+                {
+                    destination = rotated;
+                }
+                else
+                {
+                    evaluator.add_inplace(destination, rotated);
+                }
+            }
+        }
+
+        vector<double> reference(const vector<double> &x) const
+        {
+            size_t n = x.size();
+            vector<double> y(n, 0.0);
+            for (auto &tap : taps_)
+            {
+                size_t shift = static_cast<size_t>((tap.offset % static_cast<int>(n) + static_cast<int>(n))) % n;
+                for (size_t i = 0; i < n; i++)
+                {
+                    y[i] += tap.weight * x[(i + shift) % n];
+                }
+            }
+            return y;
+        }
+
+    private:
+        SEALSession &session_;
+
+        vector<Tap> taps_;
+
+        int min_offset_ = 0;
+
+        int baby_steps_ = 1;
+
+        int giant_steps_ = 1;
+
+        vector<vector<Plaintext>> weights_;
+
+        vector<vector<bool>> present_;
+
+        const GaloisKeys *galois_keys_ = nullptr;
+    };
+
+    vector<Tap> moving_average_taps(int window)
+    {
+        vector<Tap> taps;
+        for (int k = 0; k < window; k++)
+        {
+            taps.push_back({ k, 1.0 / window });
+        }
+        return taps;
+    }
+
+    /*
+    중앙 차분 근사: x'(i) ~ (x[i+1] - x[i-1]) / 2, x''(i) ~ x[i+1] - 2x[i] + x[i-1].
+    */
+    vector<Tap> central_difference_taps(int order)
+    {
+        if (order == 1)
+        {
+            return { { -1, -0.5 }, { 1, 0.5 } };
+        }
+        return { { -1, 1.0 }, { 0, -2.0 }, { 1, 1.0 } };
+    }
+
+    vector<Tap> gaussian_taps(int radius)
+    {
+        vector<Tap> taps;
+        double sigma = max(1.0, radius / 2.0);
+        double total = 0;
+        for (int k = -radius; k <= radius; k++)
+        {
+            double w = exp(-(k * k) / (2 * sigma * sigma));
+            taps.push_back({ k, w });
+            total += w;
+        }
+        for (auto &tap : taps)
+        {
+            tap.weight /= total;
+        }
+        return taps;
+    }
+} // namespace
+
+void example_convolution()
+{
+    print_example_banner("Example: Encrypted Convolution and Stencil Kernels");
+
+    EncryptionParameters parms(scheme_type::ckks);
+    size_t poly_modulus_degree = 16384;
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, 50, 50, 50, 50, 60 }));
+    double scale = pow(2.0, 50);
+
+    auto session = SEALSession::Get(parms);
+    print_parameters(session->context());
+    cout << endl;
+
+    auto &encoder = session->ckks_encoder();
+    auto &encryptor = session->encryptor();
+    auto &decryptor = session->decryptor();
+    size_t slot_count = encoder.slot_count();
+
+    /*
+    센서 시계열을 흉내 낸 입력입니다: 느린 사인파 + 빠른 진동.
+    */
+    vector<double> series(slot_count);
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        double t = static_cast<double>(i);
+        series[i] = sin(t / 200.0) + 0.1 * sin(t / 3.0);
+    }
+    cout << "Input series:" << endl;
+    print_vector(series, 3, 7);
+
+    Plaintext plain;
+    encoder.encode(series, scale, plain);
+    Ciphertext encrypted;
+    encryptor.encrypt(plain, encrypted);
+
+    struct NamedKernel
+    {
+        string name;
+        vector<Tap> taps;
+    };
+    vector<NamedKernel> kernels = { { "moving average (3)", moving_average_taps(3) },
+                                    { "moving average (8)", moving_average_taps(8) },
+                                    { "moving average (32)", moving_average_taps(32) },
+                                    { "1st central difference", central_difference_taps(1) },
+                                    { "2nd central difference", central_difference_taps(2) },
+                                    { "gaussian (radius 8)", gaussian_taps(8) } };
+
+    chrono::high_resolution_clock::time_point time_start, time_end;
+    Ciphertext result;
+    vector<double> decoded;
+
+    for (auto &named : kernels)
+    {
+        print_line(__LINE__);
+        cout << "Kernel: " << named.name << " (" << named.taps.size() << " taps)" << endl;
+        ConvolutionKernel kernel(*session, named.taps, encrypted.parms_id(), scale);
+        vector<double> expected = kernel.reference(series);
+
+        /*
+        워밍업을 위해 각 경로를 한 번 실행한 뒤 시간을 잽니다. 특정 단계 Galois 키 생성 시간은 포함하지 않습니다.
+        */
+        int count = 5;
+
+        kernel.apply_tap_by_tap(encrypted, result, scale);
+        time_start = chrono::high_resolution_clock::now();
+        for (int c = 0; c < count; c++)
+        {
+            kernel.apply_tap_by_tap(encrypted, result, scale);
+        }
+        time_end = chrono::high_resolution_clock::now();
+        auto time_naive = chrono::duration_cast<chrono::microseconds>(time_end - time_start) / count;
+        decryptor.decrypt(result, plain);
+        encoder.decode(plain, decoded);
+        double error_naive = max_abs_error(expected, decoded);
+
+        kernel.apply(encrypted, result);
+        time_start = chrono::high_resolution_clock::now();
+        for (int c = 0; c < count; c++)
+        {
+            kernel.apply(encrypted, result);
+        }
+        time_end = chrono::high_resolution_clock::now();
+        auto time_fast = chrono::duration_cast<chrono::microseconds>(time_end - time_start) / count;
+        decryptor.decrypt(result, plain);
+        encoder.decode(plain, decoded);
+        double error_fast = max_abs_error(expected, decoded);
+
+        cout << "    + Tap-by-tap: " << setw(8) << time_naive.count() << " microseconds, max error " << error_naive
+             << endl;
+        cout << "    + Baby-step giant-step: " << setw(8) << time_fast.count() << " microseconds, max error "
+             << error_fast << ", rotations " << kernel.rotation_count() << endl;
+        print_vector(decoded, 3, 7);
+    }
+}
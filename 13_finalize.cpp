@@ -0,0 +1,204 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+
+using namespace std;
+using namespace seal;
+
+FinalizeReport finalize_ciphertext(
+    const SEALContext &context, const Evaluator &evaluator, Ciphertext &encrypted, size_t remaining_depth,
+    int headroom_bits)
+{
+    TRACE_SCOPE("finalize_ciphertext", context, encrypted);
+    FinalizeReport report;
+    auto context_data = context.get_context_data(encrypted.parms_id());
+    if (!context_data)
+    {
+        throw invalid_argument("encrypted is not valid for encryption parameters");
+    }
+    report.from_level = context_data->chain_index();
+    report.bytes_before = encrypted.save_size(compr_mode_type::none);
+
+    if (report.from_level < remaining_depth)
+    {
+        throw invalid_argument("not enough levels left for the remaining computation");
+    }
+
+    /*
+    체인을 따라 내려가면서 두 조건을 모두 만족하는 가장 낮은 레벨을 찾습니다.
+        - chain_index >= remaining_depth: 이후의 rescale에 필요한 소수가 남아 있어야 합니다.
+        - 남은 계산이 끝난 레벨, 즉 후보에서 remaining_depth만큼 내려간 레벨의 coeff_modulus 비트 수
+          >= log2(scale) + headroom_bits: 복호화는 그 레벨에서 일어나므로 거기서 값이 모듈러스를 넘지 않아야 합니다.
+    */
+    double scale_bits = log2(encrypted.scale());
+    auto target = context_data;
+    for (auto next = context_data->next_context_data(); next; next = next->next_context_data())
+    {
+        if (next->chain_index() < remaining_depth)
+        {
+            break;
+        }
+        auto decrypt_level = next;
+        for (size_t d = 0; d < remaining_depth; d++)
+        {
+            decrypt_level = decrypt_level->next_context_data();
+        }
+        if (decrypt_level->total_coeff_modulus_bit_count() < static_cast<int>(ceil(scale_bits)) + headroom_bits)
+        {
+            break;
+        }
+        target = next;
+    }
+
+    if (target != context_data)
+    {
+        evaluator.mod_switch_to_inplace(encrypted, target->parms_id());
+    }
+    report.to_level = target->chain_index();
+    report.bytes_after = encrypted.save_size(compr_mode_type::none);
+    return report;
+}
+
+/*
+계산이 끝난 암호문은 복호화에 필요하지 않은 소수들을 여전히 가지고 있습니다. 저장이나 전송 전에 mod switch로
+이 소수들을 버리면 암호문 크기가 줄고, 이후에 (남은 깊이 안에서) 수행하는 연산도 빨라집니다.
+*/
+void example_finalize()
+{
+    print_example_banner("Example: Finalize (Mod-Switch-Down)");
+
+    EncryptionParameters parms(scheme_type::ckks);
+    size_t poly_modulus_degree = 16384;
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, 50, 50, 50, 50, 60 }));
+    double scale = pow(2.0, 50);
+
+    auto session = SEALSession::Get(parms);
+    const SEALContext &context = session->context();
+    print_parameters(context);
+    cout << endl;
+
+    auto &encoder = session->ckks_encoder();
+    auto &evaluator = session->evaluator();
+    auto &relin_keys = session->relin_keys();
+    auto &encryptor = session->encryptor();
+    auto &decryptor = session->decryptor();
+    size_t slot_count = encoder.slot_count();
+
+    vector<double> input(slot_count), expected(slot_count);
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        input[i] = static_cast<double>(i) / static_cast<double>(slot_count - 1);
+        expected[i] = input[i] * input[i];
+    }
+
+    /*
+    x^2를 계산하여 한 레벨만 사용한 결과를 만듭니다.
+    */
+    print_line(__LINE__);
+    cout << "Compute x^2 (one level consumed)." << endl;
+    Plaintext plain;
+    encoder.encode(input, scale, plain);
+    Ciphertext encrypted;
+    encryptor.encrypt(plain, encrypted);
+    evaluator.square_inplace(encrypted);
+    evaluator.relinearize_inplace(encrypted, relin_keys);
+    evaluator.rescale_to_next_inplace(encrypted);
+    cout << "    + Modulus chain index: " << context.get_context_data(encrypted.parms_id())->chain_index() << endl;
+
+    /*
+    결과를 다른 곳으로 보내기 전에, 받는 쪽에서 곱셈 깊이 1의 계산(예: 가중치 곱)을 더 한다고 선언하고
+    finalize합니다. 그리고 더 이상 계산이 없는 경우와 비교합니다.
+    */
+    for (size_t remaining_depth : { size_t(2), size_t(1), size_t(0) })
+    {
+        Ciphertext finalized = encrypted;
+        FinalizeReport report = finalize_ciphertext(context, evaluator, finalized, remaining_depth);
+
+        print_line(__LINE__);
+        cout << "Finalize with remaining depth " << remaining_depth << "." << endl;
+        cout << "    + Level " << report.from_level << " -> " << report.to_level << endl;
+        cout << "    + Serialized size: " << report.bytes_before << " -> " << report.bytes_after << " bytes ("
+             << report.bytes_saved() << " bytes saved)" << endl;
+
+        /*
+        선언한 만큼의 깊이가 실제로 남아 있는지 확인합니다.
+        */
+        for (size_t d = 0; d < remaining_depth; d++)
+        {
+            Plaintext plain_weight;
+            encoder.encode(1.0, finalized.parms_id(), scale, plain_weight);
+            evaluator.multiply_plain_inplace(finalized, plain_weight);
+            evaluator.rescale_to_next_inplace(finalized);
+            finalized.scale() = scale;
+        }
+
+        chrono::high_resolution_clock::time_point time_start, time_end;
+        time_start = chrono::high_resolution_clock::now();
+        decryptor.decrypt(finalized, plain);
+        time_end = chrono::high_resolution_clock::now();
+        vector<double> result;
+        encoder.decode(plain, result);
+        cout << "    + Decrypt after " << remaining_depth << " further rescale(s): "
+             << chrono::duration_cast<chrono::microseconds>(time_end - time_start).count()
+             << " microseconds, max error " << max_abs_error(expected, result) << endl;
+    }
+
+    /*
+    헤드룸은 남은 계산이 끝난 레벨에서 확인해야 합니다. 맨 아래 소수가 스케일보다 작은 체인에서는 레벨 1이 충분히
+    커 보여도, 거기서 한 번 더 rescale하면 레벨 0에서 값이 모듈러스를 넘습니다.
+    */
+    print_line(__LINE__);
+    cout << "Finalize with remaining depth 1 on a chain whose last prime (35 bits) is below the scale (2^40)." << endl;
+    {
+        EncryptionParameters small_parms(scheme_type::ckks);
+        small_parms.set_poly_modulus_degree(poly_modulus_degree);
+        small_parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 35, 40, 40, 40, 60 }));
+        double small_scale = pow(2.0, 40);
+
+        auto small_session = SEALSession::Get(small_parms);
+        const SEALContext &small_context = small_session->context();
+        auto &small_encoder = small_session->ckks_encoder();
+        auto &small_evaluator = small_session->evaluator();
+        auto &small_decryptor = small_session->decryptor();
+
+        Ciphertext small_encrypted;
+        small_encoder.encode(input, small_scale, plain);
+        small_session->encryptor().encrypt(plain, small_encrypted);
+        small_evaluator.square_inplace(small_encrypted);
+        small_evaluator.relinearize_inplace(small_encrypted, small_session->relin_keys());
+        small_evaluator.rescale_to_next_inplace(small_encrypted);
+        small_encrypted.scale() = small_scale;
+
+        /*
+        finalize가 고른 레벨과, 그보다 한 레벨 더 내린 경우(후보 레벨만 확인하면 고르게 되는 레벨)를 비교합니다.
+        */
+        Ciphertext finalized = small_encrypted;
+        FinalizeReport report = finalize_ciphertext(small_context, small_evaluator, finalized, 1);
+        Ciphertext too_low = finalized;
+        small_evaluator.mod_switch_to_next_inplace(too_low);
+        for (auto *candidate : { &finalized, &too_low })
+        {
+            size_t level = small_context.get_context_data(candidate->parms_id())->chain_index();
+            Plaintext plain_weight;
+            small_encoder.encode(1.0, candidate->parms_id(), small_scale, plain_weight);
+            small_evaluator.multiply_plain_inplace(*candidate, plain_weight);
+            small_evaluator.rescale_to_next_inplace(*candidate);
+            candidate->scale() = small_scale;
+
+            small_decryptor.decrypt(*candidate, plain);
+            vector<double> result;
+            small_encoder.decode(plain, result);
+            cout << "    + " << (candidate == &finalized ? "Finalized" : "One level lower") << ": level " << level
+                 << " -> decrypt at level " << level - 1 << ", max error " << max_abs_error(expected, result) << endl;
+        }
+        cout << "    + Finalize chose level " << report.to_level << endl;
+    }
+
+    /*
+    polynomial_depth를 사용하면 남은 계산을 다항식 차수로 선언할 수도 있습니다.
+    */
+    print_line(__LINE__);
+    cout << "Remaining depth for a degree-3 polynomial: " << polynomial_depth(3) << endl;
+}
@@ -0,0 +1,345 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+
+using namespace std;
+using namespace seal;
+
+/*
+CKKS는 비교 연산을 직접 지원하지 않습니다. 대신 [-1, 1]에서 sign(x)에 가까워지는 낮은 차수의 홀수 다항식을
+여러 번 합성하여 근사합니다.
+
+    f1(x) = (3x - x^3) / 2                    곱셈 깊이 2
+    f2(x) = (15x - 10x^3 + 3x^5) / 8          곱셈 깊이 3
+
+f를 반복할수록 0 근처의 전이 구간이 좁아지고 정확도가 높아지지만 레벨과 시간이 더 듭니다. sign을 얻으면
+
+    step(x)   = (1 + sign(x)) / 2
+    max(a, b) = b + (a - b) * step(a - b)
+    ReLU(x)   = x * step(x)
+
+이며, 각각 곱셈 한 번이 더 필요합니다. step의 1/2 배는 마지막 단계의 계수에 미리 곱해 두므로 레벨을 쓰지 않습니다.
+
+모든 rescale 후에는 9_my_ckks.cpp와 마찬가지로 스케일을 2^50으로 맞춥니다. 50비트 소수는 2^50에 매우 가까우므로
+오차는 무시할 수 있습니다.
+*/
+namespace
+{
+    enum class SignStage
+    {
+        f1,
+        f2
+    };
+
+    class SignApproximation
+    {
+    public:
+        SignApproximation(SEALSession &session, vector<SignStage> stages, double scale)
+            : session_(session), stages_(move(stages)), scale_(scale)
+        {
+            if (stages_.empty())
+            {
+                throw invalid_argument("at least one stage is required");
+            }
+        }
+
+        /*
+        sign 근사에 필요한 곱셈 깊이입니다.
+        */
+        size_t depth() const
+        {
+            size_t depth = 0;
+            for (auto stage : stages_)
+            {
+                depth += (stage == SignStage::f1) ? 2 : 3;
+            }
+            return depth;
+        }
+
+        string name() const
+        {
+            string name;
+            for (auto stage : stages_)
+            {
+                name += name.empty() ? "" : " o ";
+                name += (stage == SignStage::f1) ? "f1" : "f2";
+            }
+            return name;
+        }
+
+        void sign(const Ciphertext &encrypted, Ciphertext &destination) const
+        {
+            compose(encrypted, destination, 1.0);
+        }
+
+        void step(const Ciphertext &encrypted, Ciphertext &destination) const
+        {
+            compose(encrypted, destination, 0.5);
+            Plaintext plain_half;
+            session_.ckks_encoder().encode(0.5, destination.parms_id(), destination.scale(), plain_half);
+            session_.evaluator().add_plain_inplace(destination, plain_half);
+        }
+
+        void relu(const Ciphertext &encrypted, Ciphertext &destination) const
+        {
+            Ciphertext s;
+            step(encrypted, s);
+            multiply(encrypted, s, destination);
+        }
+
+        void max(const Ciphertext &a, const Ciphertext &b, Ciphertext &destination) const
+        {
+            auto &evaluator = session_.evaluator();
+            Ciphertext diff, s;
+            evaluator.sub(a, b, diff);
+            step(diff, s);
+            multiply(diff, s, destination);
+            add(destination, b);
+        }
+
+    private:
+        void compose(const Ciphertext &encrypted, Ciphertext &destination, double last_factor) const
+        {
+            destination = encrypted;
+            for (size_t k = 0; k < stages_.size(); k++)
+            {
+                double factor = (k + 1 == stages_.size()) ? last_factor : 1.0;
+                Ciphertext x = move(destination);
+                if (stages_[k] == SignStage::f1)
+                {
+                    apply_f1(x, destination, factor);
+                }
+                else
+                {
+                    apply_f2(x, destination, factor);
+                }
+            }
+        }
+
+        /*
+        factor * (1.5x - 0.5x^3). x^3의 계수는 x 쪽에 곱해 깊이를 2로 유지합니다.
+        */
+        void apply_f1(const Ciphertext &x, Ciphertext &destination, double factor) const
+        {
+            Ciphertext x2, x_coeff3, x_coeff1;
+            multiply(x, x, x2);
+            multiply_const(x, -0.5 * factor, x_coeff3);
+            multiply_const(x, 1.5 * factor, x_coeff1);
+            multiply(x2, x_coeff3, destination);
+            add(destination, x_coeff1);
+        }
+
+        /*
+        factor * (15x - 10x^3 + 3x^5) / 8. x^5 = x^4 * (3/8 x), x^3 = x^2 * (-10/8 x)로 깊이를 3으로 유지합니다.
+        */
+        void apply_f2(const Ciphertext &x, Ciphertext &destination, double factor) const
+        {
+            Ciphertext x2, x4, x_coeff5, x_coeff3, x_coeff1, x3;
+            multiply(x, x, x2);
+            multiply(x2, x2, x4);
+            multiply_const(x, 3.0 / 8 * factor, x_coeff5);
+            multiply_const(x, -10.0 / 8 * factor, x_coeff3);
+            multiply_const(x, 15.0 / 8 * factor, x_coeff1);
+            multiply(x4, x_coeff5, destination);
+            multiply(x2, x_coeff3, x3);
+            add(destination, x3);
+            add(destination, x_coeff1);
+        }
+
+        /*
+        두 암호문을 낮은 쪽 레벨에 맞춘 뒤 곱하고, 재선형화와 rescale을 수행합니다.
+        */
+        void multiply(const Ciphertext &a, const Ciphertext &b, Ciphertext &destination) const
+        {
+            auto &evaluator = session_.evaluator();
+            auto &context = session_.context();
+            size_t level_a = context.get_context_data(a.parms_id())->chain_index();
+            size_t level_b = context.get_context_data(b.parms_id())->chain_index();
+            if (level_a == level_b)
+            {
+                evaluator.multiply(a, b, destination);
+            }
+            else if (level_a > level_b)
+            {
+                Ciphertext switched;
+                evaluator.mod_switch_to(a, b.parms_id(), switched);
+                evaluator.multiply(switched, b, destination);
+            }
+            else
+            {
+                Ciphertext switched;
+                evaluator.mod_switch_to(b, a.parms_id(), switched);
+                evaluator.multiply(a, switched, destination);
+            }
+            evaluator.relinearize_inplace(destination, session_.relin_keys());
+            evaluator.rescale_to_next_inplace(destination);
+            destination.scale() = scale_;
+        }
+
+        void multiply_const(const Ciphertext &a, double value, Ciphertext &destination) const
+        {
+            Plaintext plain_value;
+            session_.ckks_encoder().encode(value, a.parms_id(), scale_, plain_value);
+            session_.evaluator().multiply_plain(a, plain_value, destination);
+            session_.evaluator().rescale_to_next_inplace(destination);
+            destination.scale() = scale_;
+        }
+
+        /*
+        destination += other. 레벨이 더 높은 쪽을 낮은 쪽으로 mod switch합니다.
+        */
+        void add(Ciphertext &destination, const Ciphertext &other) const
+        {
+            auto &evaluator = session_.evaluator();
+            auto &context = session_.context();
+            size_t level_dest = context.get_context_data(destination.parms_id())->chain_index();
+            size_t level_other = context.get_context_data(other.parms_id())->chain_index();
+            destination.scale() = scale_;
+            if (level_dest > level_other)
+            {
+                evaluator.mod_switch_to_inplace(destination, other.parms_id());
+            }
+            if (level_other > level_dest)
+            {
+                Ciphertext switched;
+                evaluator.mod_switch_to(other, destination.parms_id(), switched);
+                switched.scale() = scale_;
+                evaluator.add_inplace(destination, switched);
+            }
+            else
+            {
+                Ciphertext aligned = other;
+                aligned.scale() = scale_;
+                evaluator.add_inplace(destination, aligned);
+            }
+        }
+
+        SEALSession &session_;
+
+        vector<SignStage> stages_;
+
+        double scale_;
+    };
+} // namespace
+
+void example_comparison()
+{
+    print_example_banner("Example: Encrypted Sign, Max and ReLU");
+
+    /*
+    9_my_ckks.cpp와 같은 N = 16384, 50비트 소수 설정입니다. 가장 깊은 구성(깊이 5의 sign + 곱셈 한 번)을 위해
+    50비트 소수를 6개 사용합니다(총 420비트, 128비트 보안 한도 438비트 이내).
+    */
+    EncryptionParameters parms(scheme_type::ckks);
+    size_t poly_modulus_degree = 16384;
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, 50, 50, 50, 50, 50, 50, 60 }));
+    double scale = pow(2.0, 50);
+
+    auto session = SEALSession::Get(parms);
+    const SEALContext &context = session->context();
+    print_parameters(context);
+    cout << endl;
+
+    auto &encoder = session->ckks_encoder();
+    auto &encryptor = session->encryptor();
+    auto &decryptor = session->decryptor();
+    session->relin_keys();
+    size_t slot_count = encoder.slot_count();
+    size_t max_depth = context.first_context_data()->chain_index();
+
+    /*
+    a, b는 [0, 1]의 임의의 값이므로 a - b는 sign 근사의 정의역 [-1, 1] 안에 있습니다.
+    */
+    mt19937_64 engine(7);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    vector<double> a(slot_count), b(slot_count), x(slot_count);
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        a[i] = uniform(engine);
+        b[i] = uniform(engine);
+        x[i] = a[i] - b[i];
+    }
+
+    vector<double> expected_max(slot_count), expected_relu(slot_count);
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        expected_max[i] = std::max(a[i], b[i]);
+        expected_relu[i] = std::max(x[i], 0.0);
+    }
+
+    Plaintext plain;
+    Ciphertext encrypted_a, encrypted_b, encrypted_x;
+    encoder.encode(a, scale, plain);
+    encryptor.encrypt(plain, encrypted_a);
+    encoder.encode(b, scale, plain);
+    encryptor.encrypt(plain, encrypted_b);
+    encoder.encode(x, scale, plain);
+    encryptor.encrypt(plain, encrypted_x);
+
+    vector<vector<SignStage>> configurations = { { SignStage::f1 },
+                                                 { SignStage::f2 },
+                                                 { SignStage::f1, SignStage::f1 },
+                                                 { SignStage::f1, SignStage::f2 },
+                                                 { SignStage::f2, SignStage::f1 } };
+
+    chrono::high_resolution_clock::time_point time_start, time_end;
+    vector<double> result;
+    Ciphertext encrypted_result;
+
+    for (auto &stages : configurations)
+    {
+        SignApproximation approx(*session, stages, scale);
+        if (approx.depth() + 1 > max_depth)
+        {
+            continue;
+        }
+
+        print_line(__LINE__);
+        cout << "Sign approximation " << approx.name() << " (depth " << approx.depth() << ")" << endl;
+
+        /*
+        sign 정확도는 0에서 멀어진 구간 |x| >= delta에서 측정합니다. 0 근처는 어떤 다항식으로도 근사할 수 없습니다.
+        */
+        time_start = chrono::high_resolution_clock::now();
+        approx.sign(encrypted_x, encrypted_result);
+        time_end = chrono::high_resolution_clock::now();
+        auto time_sign = chrono::duration_cast<chrono::microseconds>(time_end - time_start);
+        decryptor.decrypt(encrypted_result, plain);
+        encoder.decode(plain, result);
+        for (double delta : { 0.25, 0.1 })
+        {
+            double error = 0;
+            for (size_t i = 0; i < slot_count; i++)
+            {
+                if (fabs(x[i]) >= delta)
+                {
+                    error = std::max(error, fabs(result[i] - (x[i] > 0 ? 1.0 : -1.0)));
+                }
+            }
+            cout << "    + sign: max error for |x| >= " << delta << ": " << error << endl;
+        }
+        cout << "    + sign latency: " << time_sign.count() << " microseconds" << endl;
+
+        time_start = chrono::high_resolution_clock::now();
+        approx.max(encrypted_a, encrypted_b, encrypted_result);
+        time_end = chrono::high_resolution_clock::now();
+        auto time_max = chrono::duration_cast<chrono::microseconds>(time_end - time_start);
+        decryptor.decrypt(encrypted_result, plain);
+        encoder.decode(plain, result);
+        cout << "    + max(a, b): " << time_max.count() << " microseconds, max error "
+             << max_abs_error(expected_max, result) << endl;
+
+        time_start = chrono::high_resolution_clock::now();
+        approx.relu(encrypted_x, encrypted_result);
+        time_end = chrono::high_resolution_clock::now();
+        auto time_relu = chrono::duration_cast<chrono::microseconds>(time_end - time_start);
+        decryptor.decrypt(encrypted_result, plain);
+        encoder.decode(plain, result);
+        cout << "    + ReLU(a - b): " << time_relu.count() << " microseconds, max error "
+             << max_abs_error(expected_relu, result) << endl;
+        cout << "    + Levels left: " << context.get_context_data(encrypted_result.parms_id())->chain_index()
+             << endl;
+    }
+}
@@ -0,0 +1,478 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+
+using namespace std;
+using namespace seal;
+
+/*
+지금까지의 예제는 true_result를 스칼라 반복문으로 계산하여 하나의 고정된 다항식만 확인합니다. 여기서는 무작위
+회로(덧셈, 뺄셈, 곱셈, 회전, 평문 연산)를 만들어 암호문 위에서 평가한 결과와 평문 참조 평가기의 결과를 비교합니다.
+평가 경로를 최적화할 때마다 이 하네스를 많은 시드로 돌려 결과가 바뀌지 않았는지 확인할 수 있습니다.
+
+참조 평가기는 슬롯 벡터 전체를 한 번에 처리하는 단순한 반복문(나머지 연산이나 분기가 없는)으로 작성되어
+컴파일러가 SIMD 명령으로 자동 벡터화할 수 있습니다. 회전은 두 번의 연속 복사로 구현합니다.
+
+회로는 SSA 형태입니다: 각 연산은 기존 레지스터를 읽어 새 레지스터 하나를 만듭니다. 생성기는 각 레지스터가 사용한
+곱셈 깊이를 추적하여 modulus switching chain을 넘는 회로는 만들지 않습니다. 또한 각 레지스터 값의 크기 상한을
+추적하여, 마지막 레벨의 coeff_modulus에 scale을 곱한 값이 담기지 않을 만큼 커지는 회로도 만들지 않습니다. 그런
+회로에서는 올바른 평가기도 틀린 결과를 내므로 하네스가 검사하려는 것과 무관한 실패가 되기 때문입니다.
+*/
+namespace
+{
+    enum class OpKind
+    {
+        add,
+        sub,
+        multiply,
+        square,
+        negate,
+        rotate,
+        add_plain,
+        multiply_plain
+    };
+
+    struct Op
+    {
+        OpKind kind;
+        size_t a = 0;
+        size_t b = 0;
+        int step = 0;
+        size_t plain_index = 0;
+    };
+
+    struct Circuit
+    {
+        size_t input_count = 0;
+        vector<Op> ops;
+        vector<vector<double>> plain_values;
+        size_t depth = 0;
+    };
+
+    const char *op_name(OpKind kind)
+    {
+        switch (kind)
+        {
+        case OpKind::add:
+            return "add";
+        case OpKind::sub:
+            return "sub";
+        case OpKind::multiply:
+            return "multiply";
+        case OpKind::square:
+            return "square";
+        case OpKind::negate:
+            return "negate";
+        case OpKind::rotate:
+            return "rotate";
+        case OpKind::add_plain:
+            return "add_plain";
+        case OpKind::multiply_plain:
+            return "multiply_plain";
+        }
+        return "unknown";
+    }
+
+    const vector<int> rotation_steps = { 1, 2, 3, 5, 16, -1, -7 };
+
+    Circuit generate_circuit(
+        mt19937_64 &engine, size_t input_count, size_t op_count, size_t max_depth, double max_magnitude,
+        size_t slot_count)
+    {
+        Circuit circuit;
+        circuit.input_count = input_count;
+        vector<size_t> depth(input_count, 0);
+
+        /*
+        |값|의 상한입니다. 입력과 평문은 [-1, 1]에서 뽑으므로 입력의 상한은 1입니다. 덧셈과 뺄셈은 상한을 더하고,
+        곱셈은 곱하며, 평문 덧셈은 1을 더하고, negate, 회전, 평문 곱셈은 그대로 둡니다.
+        */
+        vector<double> bound(input_count, 1.0);
+
+        /*
+        negate만으로 이어진 레지스터들은 같은 값의 부호만 다릅니다. 각 레지스터의 (원래 레지스터, 부호)를 기록해 두고
+        결과가 정확히 0이 되는 add(r, -r)와 sub(r, r)는 만들지 않습니다. SEAL은 투명한(모두 0인) 암호문을 결과로
+        만드는 연산에서 예외를 던지기 때문입니다.
+        */
+        vector<size_t> value_base(input_count);
+        iota(value_base.begin(), value_base.end(), size_t(0));
+        vector<bool> value_negated(input_count, false);
+        uniform_int_distribution<int> kind_dist(0, 7);
+        uniform_int_distribution<size_t> step_dist(0, rotation_steps.size() - 1);
+        uniform_real_distribution<double> value_dist(-1.0, 1.0);
+
+        auto random_plain = [&]() {
+            vector<double> values(slot_count);
+            for (auto &v : values)
+            {
+                v = value_dist(engine);
+            }
+            circuit.plain_values.push_back(move(values));
+            return circuit.plain_values.size() - 1;
+        };
+
+        while (circuit.ops.size() < op_count)
+        {
+            /*
+            앞쪽 레지스터보다 최근 레지스터를 더 자주 고르도록 하여 깊은 의존 사슬이 생기게 합니다.
+            */
+            uniform_int_distribution<size_t> reg_dist(0, depth.size() - 1);
+            auto pick = [&]() { return max(reg_dist(engine), reg_dist(engine)); };
+
+            Op op;
+            op.kind = static_cast<OpKind>(kind_dist(engine));
+            op.a = pick();
+            op.b = pick();
+            size_t result_depth = depth[op.a];
+            double result_bound = bound[op.a];
+            switch (op.kind)
+            {
+            case OpKind::add:
+            case OpKind::sub:
+                result_depth = max(depth[op.a], depth[op.b]);
+                result_bound = bound[op.a] + bound[op.b];
+                break;
+            case OpKind::multiply:
+                result_depth = max(depth[op.a], depth[op.b]) + 1;
+                result_bound = bound[op.a] * bound[op.b];
+                break;
+            case OpKind::square:
+                result_depth = depth[op.a] + 1;
+                result_bound = bound[op.a] * bound[op.a];
+                break;
+            case OpKind::multiply_plain:
+                result_depth = depth[op.a] + 1;
+                break;
+            case OpKind::add_plain:
+                result_bound = bound[op.a] + 1.0;
+                break;
+            case OpKind::rotate:
+                op.step = rotation_steps[step_dist(engine)];
+                break;
+            default:
+                break;
+            }
+            if (result_depth > max_depth || result_bound > max_magnitude)
+            {
+                continue;
+            }
+            bool same_base = value_base[op.a] == value_base[op.b];
+            bool same_sign = value_negated[op.a] == value_negated[op.b];
+            if ((op.kind == OpKind::add && same_base && !same_sign) ||
+                (op.kind == OpKind::sub && same_base && same_sign))
+            {
+                continue;
+            }
+            if (op.kind == OpKind::negate)
+            {
+                value_base.push_back(value_base[op.a]);
+                value_negated.push_back(!value_negated[op.a]);
+            }
+            else
+            {
+                value_base.push_back(depth.size());
+                value_negated.push_back(false);
+            }
+            if (op.kind == OpKind::add_plain || op.kind == OpKind::multiply_plain)
+            {
+                op.plain_index = random_plain();
+            }
+            depth.push_back(result_depth);
+            bound.push_back(result_bound);
+            circuit.depth = max(circuit.depth, result_depth);
+            circuit.ops.push_back(op);
+        }
+        return circuit;
+    }
+
+    /*
+    평문 참조 평가기입니다.
+    */
+    vector<double> evaluate_reference(const Circuit &circuit, const vector<vector<double>> &inputs)
+    {
+        vector<vector<double>> regs(inputs);
+        regs.reserve(inputs.size() + circuit.ops.size());
+        size_t n = inputs[0].size();
+        for (auto &op : circuit.ops)
+        {
+            vector<double> out(n);
+            const double *a = regs[op.a].data();
+            const double *b = regs[op.b].data();
+            double *o = out.data();
+            const double *p = (op.kind == OpKind::add_plain || op.kind == OpKind::multiply_plain)
+                                  ? circuit.plain_values[op.plain_index].data()
+                                  : nullptr;
+            switch (op.kind)
+            {
+            case OpKind::add:
+                for (size_t i = 0; i < n; i++)
+                {
+                    o[i] = a[i] + b[i];
+                }
+                break;
+            case OpKind::sub:
+                for (size_t i = 0; i < n; i++)
+                {
+                    o[i] = a[i] - b[i];
+                }
+                break;
+            case OpKind::multiply:
+                for (size_t i = 0; i < n; i++)
+                {
+                    o[i] = a[i] * b[i];
+                }
+                break;
+            case OpKind::square:
+                for (size_t i = 0; i < n; i++)
+                {
+                    o[i] = a[i] * a[i];
+                }
+                break;
+            case OpKind::negate:
+                for (size_t i = 0; i < n; i++)
+                {
+                    o[i] = -a[i];
+                }
+                break;
+            case OpKind::rotate:
+            {
+                size_t shift = static_cast<size_t>((op.step % static_cast<int>(n) + static_cast<int>(n))) % n;
+                copy(a + shift, a + n, o);
+                copy(a, a + shift, o + (n - shift));
+                break;
+            }
+            case OpKind::add_plain:
+                for (size_t i = 0; i < n; i++)
+                {
+                    o[i] = a[i] + p[i];
+                }
+                break;
+            case OpKind::multiply_plain:
+                for (size_t i = 0; i < n; i++)
+                {
+                    o[i] = a[i] * p[i];
+                }
+                break;
+            }
+            regs.push_back(move(out));
+        }
+        return regs.back();
+    }
+
+    /*
+    동형 평가기입니다. 레벨이 다른 피연산자는 낮은 쪽으로 mod switch하고, rescale 후의 스케일은 예제들과 같이
+    명목 스케일로 맞춥니다.
+    */
+    class HomomorphicEvaluator
+    {
+    public:
+        HomomorphicEvaluator(SEALSession &session, double scale) : session_(session), scale_(scale)
+        {
+            galois_keys_ = &session_.galois_keys(rotation_steps);
+        }
+
+        Ciphertext evaluate(const Circuit &circuit, const vector<Ciphertext> &inputs) const
+        {
+            auto &evaluator = session_.evaluator();
+            auto &encoder = session_.ckks_encoder();
+            auto &relin_keys = session_.relin_keys();
+
+            vector<Ciphertext> regs(inputs);
+            regs.reserve(inputs.size() + circuit.ops.size());
+            for (auto &op : circuit.ops)
+            {
+                Ciphertext out;
+                Plaintext plain;
+                switch (op.kind)
+                {
+                case OpKind::add:
+                case OpKind::sub:
+                case OpKind::multiply:
+                {
+                    Ciphertext a = regs[op.a];
+                    Ciphertext b = regs[op.b];
+                    align(a, b);
+                    if (op.kind == OpKind::add)
+                    {
+                        evaluator.add(a, b, out);
+                    }
+                    else if (op.kind == OpKind::sub)
+                    {
+                        evaluator.sub(a, b, out);
+                    }
+                    else
+                    {
+                        evaluator.multiply(a, b, out);
+                        evaluator.relinearize_inplace(out, relin_keys);
+                        evaluator.rescale_to_next_inplace(out);
+                        out.scale() = scale_;
+                    }
+                    break;
+                }
+                case OpKind::square:
+                    evaluator.square(regs[op.a], out);
+                    evaluator.relinearize_inplace(out, relin_keys);
+                    evaluator.rescale_to_next_inplace(out);
+                    out.scale() = scale_;
+                    break;
+                case OpKind::negate:
+                    evaluator.negate(regs[op.a], out);
+                    break;
+                case OpKind::rotate:
+                    evaluator.rotate_vector(regs[op.a], op.step, *galois_keys_, out);
+                    break;
+                case OpKind::add_plain:
+                    encoder.encode(circuit.plain_values[op.plain_index], regs[op.a].parms_id(), scale_, plain);
+                    evaluator.add_plain(regs[op.a], plain, out);
+                    break;
+                case OpKind::multiply_plain:
+                    encoder.encode(circuit.plain_values[op.plain_index], regs[op.a].parms_id(), scale_, plain);
+                    evaluator.multiply_plain(regs[op.a], plain, out);
+                    evaluator.rescale_to_next_inplace(out);
+                    out.scale() = scale_;
+                    break;
+                }
+                regs.push_back(move(out));
+            }
+            return regs.back();
+        }
+
+    private:
+        void align(Ciphertext &a, Ciphertext &b) const
+        {
+            auto &context = session_.context();
+            auto &evaluator = session_.evaluator();
+            size_t level_a = context.get_context_data(a.parms_id())->chain_index();
+            size_t level_b = context.get_context_data(b.parms_id())->chain_index();
+            if (level_a > level_b)
+            {
+                evaluator.mod_switch_to_inplace(a, b.parms_id());
+            }
+            else if (level_b > level_a)
+            {
+                evaluator.mod_switch_to_inplace(b, a.parms_id());
+            }
+            a.scale() = scale_;
+            b.scale() = scale_;
+        }
+
+        SEALSession &session_;
+
+        double scale_;
+
+        const GaloisKeys *galois_keys_ = nullptr;
+    };
+} // namespace
+
+void example_differential()
+{
+    print_example_banner("Example: Randomized Differential Verification");
+
+    EncryptionParameters parms(scheme_type::ckks);
+    size_t poly_modulus_degree = 16384;
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, 40, 40, 40, 40, 40, 40, 40, 60 }));
+    double scale = pow(2.0, 40);
+
+    auto session = SEALSession::Get(parms);
+    const SEALContext &context = session->context();
+    print_parameters(context);
+    cout << endl;
+
+    auto &encoder = session->ckks_encoder();
+    auto &encryptor = session->encryptor();
+    auto &decryptor = session->decryptor();
+    session->relin_keys();
+    size_t slot_count = encoder.slot_count();
+    size_t max_depth = context.first_context_data()->chain_index();
+
+    /*
+    결과는 마지막 레벨까지 내려갈 수 있으므로, 값 * scale이 그 레벨의 coeff_modulus보다 2^10 이상 작도록 값의 크기를
+    2^(마지막 레벨의 비트 수 - log2(scale) - 10)으로 제한합니다.
+    */
+    int magnitude_margin_bits = 10;
+    double max_magnitude = pow(
+        2.0, context.last_context_data()->total_coeff_modulus_bit_count() - log2(scale) - magnitude_margin_bits);
+
+    /*
+    허용 오차는 참조 결과의 크기에 대한 상대 오차입니다: |he - ref| <= bound * max(1, max|ref|).
+    */
+    size_t circuit_count = 20;
+    size_t input_count = 3;
+    size_t op_count = 16;
+    double error_bound = 1e-4;
+    uint64_t base_seed = 20231018;
+
+    HomomorphicEvaluator he(*session, scale);
+    size_t failures = 0;
+    chrono::microseconds total_he(0), total_reference(0);
+    chrono::high_resolution_clock::time_point time_start, time_end;
+
+    print_line(__LINE__);
+    cout << "Run " << circuit_count << " random circuits (" << op_count << " ops, " << input_count
+         << " inputs, depth <= " << max_depth << ", |value| <= " << max_magnitude << ")" << endl;
+    for (size_t c = 0; c < circuit_count; c++)
+    {
+        uint64_t seed = base_seed + c;
+        mt19937_64 engine(seed);
+        Circuit circuit = generate_circuit(engine, input_count, op_count, max_depth, max_magnitude, slot_count);
+
+        uniform_real_distribution<double> value_dist(-1.0, 1.0);
+        vector<vector<double>> inputs(input_count, vector<double>(slot_count));
+        vector<Ciphertext> encrypted_inputs(input_count);
+        Plaintext plain;
+        for (size_t k = 0; k < input_count; k++)
+        {
+            for (auto &v : inputs[k])
+            {
+                v = value_dist(engine);
+            }
+            encoder.encode(inputs[k], scale, plain);
+            encryptor.encrypt(plain, encrypted_inputs[k]);
+        }
+
+        time_start = chrono::high_resolution_clock::now();
+        Ciphertext encrypted_result = he.evaluate(circuit, encrypted_inputs);
+        time_end = chrono::high_resolution_clock::now();
+        auto time_he = chrono::duration_cast<chrono::microseconds>(time_end - time_start);
+
+        time_start = chrono::high_resolution_clock::now();
+        vector<double> expected = evaluate_reference(circuit, inputs);
+        time_end = chrono::high_resolution_clock::now();
+        auto time_reference = chrono::duration_cast<chrono::microseconds>(time_end - time_start);
+
+        vector<double> result;
+        decryptor.decrypt(encrypted_result, plain);
+        encoder.decode(plain, result);
+
+        double magnitude = 1.0;
+        double error = 0;
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            magnitude = max(magnitude, fabs(expected[i]));
+            error = max(error, fabs(expected[i] - result[i]));
+        }
+        bool passed = error <= error_bound * magnitude;
+        failures += passed ? 0 : 1;
+        total_he += time_he;
+        total_reference += time_reference;
+
+        cout << "    + seed " << seed << ": depth " << circuit.depth << ", HE " << setw(7) << time_he.count()
+             << " us, reference " << setw(5) << time_reference.count() << " us, error " << error << " / "
+             << magnitude << (passed ? "" : "  <-- FAILED") << endl;
+        if (!passed)
+        {
+            for (auto &op : circuit.ops)
+            {
+                cout << "        " << op_name(op.kind) << "(" << op.a << ", " << op.b << ", step " << op.step << ")"
+                     << endl;
+            }
+        }
+    }
+
+    print_line(__LINE__);
+    cout << "Summary: " << (circuit_count - failures) << "/" << circuit_count << " circuits passed" << endl;
+    cout << "    + Total HE time: " << total_he.count() << " microseconds" << endl;
+    cout << "    + Total reference time: " << total_reference.count() << " microseconds" << endl;
+}
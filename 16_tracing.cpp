@@ -0,0 +1,358 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+
+using namespace std;
+using namespace seal;
+
+namespace
+{
+    struct TraceEvent
+    {
+        const char *name;
+        chrono::steady_clock::time_point start;
+        chrono::steady_clock::time_point end;
+        long level;
+        size_t size;
+    };
+
+    /*
+    각 스레드는 자신의 thread_local 버퍼에 잠금 없이 기록합니다. 버퍼는 flush_threshold개가 차거나 스레드가 끝날 때
+    flush되어 전역 목록으로 옮겨지며, 잠금은 이때만 잡습니다. 따라서 다른 스레드가 아직 flush하지 않은 이벤트는
+    EventCount()와 WriteChromeTrace()에 보이지 않습니다. 이 두 함수는 호출한 스레드의 버퍼만 먼저 flush합니다.
+
+    Clear()는 세대 번호를 올립니다. 버퍼의 이벤트가 이전 세대의 것이면 다음 기록이나 flush에서 버려지므로, Clear()는
+    다른 스레드의 버퍼를 건드리지 않습니다.
+    */
+    constexpr size_t flush_threshold = 4096;
+
+    struct FlushedEvents
+    {
+        uint64_t tid = 0;
+        vector<TraceEvent> events;
+    };
+
+    mutex &flushed_mutex()
+    {
+        static mutex flushed_mutex;
+        return flushed_mutex;
+    }
+
+    vector<FlushedEvents> &flushed()
+    {
+        static vector<FlushedEvents> flushed;
+        return flushed;
+    }
+
+    atomic<uint64_t> &current_generation()
+    {
+        static atomic<uint64_t> generation{ 0 };
+        return generation;
+    }
+
+    chrono::steady_clock::time_point &trace_origin()
+    {
+        static chrono::steady_clock::time_point origin = chrono::steady_clock::now();
+        return origin;
+    }
+
+    struct ThreadBuffer
+    {
+        uint64_t tid = 0;
+        uint64_t generation = 0;
+        vector<TraceEvent> events;
+
+        void flush()
+        {
+            if (events.empty())
+            {
+                return;
+            }
+            lock_guard<mutex> lock(flushed_mutex());
+            if (generation == current_generation().load(memory_order_relaxed))
+            {
+                flushed().push_back({ tid, move(events) });
+            }
+            events = vector<TraceEvent>();
+        }
+
+        /*
+        스레드가 끝날 때 남은 이벤트를 flush합니다.
+        */
+        ~ThreadBuffer()
+        {
+            try
+            {
+                flush();
+            }
+            catch (...)
+            {
+            }
+        }
+    };
+
+    ThreadBuffer &thread_buffer()
+    {
+        static atomic<uint64_t> next_tid{ 1 };
+        thread_local ThreadBuffer buffer;
+        if (buffer.tid == 0)
+        {
+            buffer.tid = next_tid++;
+            buffer.generation = current_generation().load(memory_order_relaxed);
+        }
+        return buffer;
+    }
+
+    string json_escape(const char *text)
+    {
+        string escaped;
+        for (const char *c = text; *c; c++)
+        {
+            if (*c == '"' || *c == '\\')
+            {
+                escaped.push_back('\\');
+            }
+            escaped.push_back(*c);
+        }
+        return escaped;
+    }
+} // namespace
+
+void Tracer::Enable()
+{
+    trace_origin();
+    enabled_.store(true, memory_order_relaxed);
+}
+
+void Tracer::Disable()
+{
+    enabled_.store(false, memory_order_relaxed);
+}
+
+void Tracer::Clear()
+{
+    lock_guard<mutex> lock(flushed_mutex());
+    current_generation()++;
+    vector<FlushedEvents>().swap(flushed());
+}
+
+size_t Tracer::EventCount()
+{
+    thread_buffer().flush();
+    size_t count = 0;
+    lock_guard<mutex> lock(flushed_mutex());
+    for (auto &entry : flushed())
+    {
+        count += entry.events.size();
+    }
+    return count;
+}
+
+void Tracer::Record(
+    const char *name, chrono::steady_clock::time_point start, chrono::steady_clock::time_point end, long level,
+    size_t size)
+{
+    /*
+    ScopedTrace의 소멸자에서 호출되므로 예외를 밖으로 내보내지 않습니다. 메모리가 부족하면 이벤트를 버립니다.
+    */
+    try
+    {
+        auto &buffer = thread_buffer();
+        uint64_t current = current_generation().load(memory_order_relaxed);
+        if (buffer.generation != current)
+        {
+            buffer.events.clear();
+            buffer.generation = current;
+        }
+        if (buffer.events.empty())
+        {
+            buffer.events.reserve(flush_threshold);
+        }
+        buffer.events.push_back({ name, start, end, level, size });
+        if (buffer.events.size() >= flush_threshold)
+        {
+            buffer.flush();
+        }
+    }
+    catch (...)
+    {
+    }
+}
+
+bool Tracer::WriteChromeTrace(const string &path)
+{
+    ofstream stream(path, ios::out | ios::trunc);
+    if (!stream)
+    {
+        return false;
+    }
+
+    auto origin = trace_origin();
+    auto to_us = [&origin](chrono::steady_clock::time_point t) {
+        return chrono::duration<double, micro>(t - origin).count();
+    };
+
+    stream << fixed << setprecision(3);
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto write_events = [&](uint64_t tid, const vector<TraceEvent> &events) {
+        for (auto &event : events)
+        {
+            stream << (first ? "\n" : ",\n");
+            first = false;
+            stream << "{\"name\":\"" << json_escape(event.name) << "\",\"cat\":\"seal\",\"ph\":\"X\""
+                   << ",\"ts\":" << to_us(event.start) << ",\"dur\":" << to_us(event.end) - to_us(event.start)
+                   << ",\"pid\":1,\"tid\":" << tid << ",\"args\":{";
+            if (event.level >= 0)
+            {
+                stream << "\"level\":" << event.level << ",\"size\":" << event.size;
+            }
+            stream << "}}";
+        }
+    };
+    thread_buffer().flush();
+    lock_guard<mutex> lock(flushed_mutex());
+    for (auto &entry : flushed())
+    {
+        write_events(entry.tid, entry.events);
+    }
+    stream << "\n]}\n";
+    return static_cast<bool>(stream);
+}
+
+/*
+키 생성, 인코딩, 암호화, Evaluator 호출, 복호화/디코딩 구간을 추적하여 Chrome trace 파일로 씁니다.
+SEAL_EXAMPLES_TRACE=ON으로 빌드해야 TRACE_SCOPE가 이벤트를 기록합니다.
+*/
+void example_tracing()
+{
+    print_example_banner("Example: Scoped Tracing");
+
+#ifndef SEAL_EXAMPLES_TRACE
+    cout << "Tracing is compiled out. Reconfigure with -DSEAL_EXAMPLES_TRACE=ON to record events." << endl;
+#endif
+
+    Tracer::Clear();
+    Tracer::Enable();
+
+    /*
+    세션이 처음 만들어지는 경우에는 키 생성도 기록됩니다(10_session.cpp).
+    */
+    EncryptionParameters parms(scheme_type::ckks);
+    size_t poly_modulus_degree = 16384;
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, 50, 50, 50, 50, 60 }));
+    double scale = pow(2.0, 50);
+
+    auto session = SEALSession::Get(parms);
+    const SEALContext &context = session->context();
+    print_parameters(context);
+    cout << endl;
+
+    auto &encoder = session->ckks_encoder();
+    auto &evaluator = session->evaluator();
+    auto &relin_keys = session->relin_keys();
+    auto &galois_keys = session->galois_keys();
+    auto &encryptor = session->encryptor();
+    auto &decryptor = session->decryptor();
+    size_t slot_count = encoder.slot_count();
+
+    vector<double> input(slot_count);
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        input[i] = static_cast<double>(i) / static_cast<double>(slot_count - 1);
+    }
+
+    /*
+    SEALSession이 돌려주는 Evaluator, 인코더, Encryptor, Decryptor는 모든 연산을 스스로 기록하므로(examples.h의
+    TracedEvaluator 등) 회로 코드에는 추적 코드가 필요 없습니다. 여기서는 요청 하나 전체를 묶는 구간만 추가합니다.
+    9_my_ckks.cpp의 (x + 1)^2 * (x^2 + 2)를 여러 스레드에서 동시에 평가하며, 각 스레드의 이벤트는 trace에서 별도의
+    트랙으로 나타납니다.
+    */
+    auto run = [&]() {
+        TRACE_SCOPE("request");
+        Plaintext plain, plain_one, plain_two;
+        encoder.encode(input, scale, plain);
+        encoder.encode(1.0, scale, plain_one);
+        Ciphertext x;
+        encryptor.encrypt(plain, x);
+
+        Ciphertext x2;
+        evaluator.square(x, x2);
+        evaluator.relinearize_inplace(x2, relin_keys);
+        evaluator.rescale_to_next_inplace(x2);
+        x2.scale() = scale;
+        encoder.encode(2.0, x2.parms_id(), scale, plain_two);
+        evaluator.add_plain_inplace(x2, plain_two);
+
+        Ciphertext y;
+        evaluator.add_plain_inplace(x, plain_one);
+        evaluator.square(x, y);
+        evaluator.relinearize_inplace(y, relin_keys);
+        evaluator.rescale_to_next_inplace(y);
+        y.scale() = scale;
+
+        evaluator.multiply_inplace(x2, y);
+        evaluator.relinearize_inplace(x2, relin_keys);
+        evaluator.rescale_to_next_inplace(x2);
+        finalize_ciphertext(context, evaluator, x2);
+        evaluator.rotate_vector_inplace(x2, 2, galois_keys);
+
+        vector<double> result;
+        decryptor.decrypt(x2, plain);
+        encoder.decode(plain, result);
+        return result;
+    };
+
+    print_line(__LINE__);
+    size_t thread_count = min<size_t>(4, max<size_t>(1, thread::hardware_concurrency()));
+    cout << "Evaluate (x + 1)^2 * (x^2 + 2) and rotate on " << thread_count << " threads." << endl;
+    vector<thread> threads;
+    vector<vector<double>> results(thread_count);
+    for (size_t t = 0; t < thread_count; t++)
+    {
+        threads.emplace_back([&run, &results, t]() { results[t] = run(); });
+    }
+    for (auto &th : threads)
+    {
+        th.join();
+    }
+    print_vector(results[0], 3, 7);
+
+    /*
+    기존 예제도 코드 변경 없이 추적됩니다.
+    */
+    print_line(__LINE__);
+    cout << "Trace example_my_ckks() unchanged." << endl;
+    example_my_ckks();
+
+    Tracer::Disable();
+
+    /*
+    추적이 꺼져 있을 때의 비용: ScopedTrace 하나는 atomic 플래그를 한 번 읽을 뿐입니다.
+    */
+    print_line(__LINE__);
+    cout << "Measure the cost of a disabled scope." << endl;
+    size_t iterations = 10000000;
+    auto time_start = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        TRACE_SCOPE("disabled");
+    }
+    auto time_end = chrono::high_resolution_clock::now();
+    cout << "    + " << chrono::duration<double, nano>(time_end - time_start).count() / iterations
+         << " nanoseconds per disabled scope" << endl;
+
+    string path = "seal_trace.json";
+    print_line(__LINE__);
+    cout << "Write " << Tracer::EventCount() << " events to " << path << "." << endl;
+    if (Tracer::WriteChromeTrace(path))
+    {
+        cout << "    + Open it in chrome://tracing or https://ui.perfetto.dev" << endl;
+    }
+    else
+    {
+        cout << "    + Could not write " << path << endl;
+    }
+}
@@ -0,0 +1,320 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+
+using namespace std;
+using namespace seal;
+
+/*
+암호화된 특성 벡터에 대한 선형/로지스틱 모델 추론입니다. 샘플 하나를 암호문 하나로 암호화하면 슬롯 대부분이
+낭비되므로, 여기서는 d개의 특성을 2의 거듭제곱 D >= d로 채워 블록을 만들고 한 암호문에 slot_count / D개의
+샘플을 담습니다.
+
+    슬롯:  [ x_0,0 ... x_0,d-1 0 ... 0 | x_1,0 ... x_1,d-1 0 ... 0 | ... ]
+             \_______ 블록 0 (D) _____/  \_______ 블록 1 (D) _____/
+
+가중합 w . x_s + b는 다음과 같이 모든 샘플에 대해 동시에 계산됩니다.
+    1. 블록마다 반복된 가중치 평문과 multiply_plain (평문은 미리 인코딩해 둡니다)
+    2. log2(D)번의 rotate-and-sum: ct += rot(ct, 1), ct += rot(ct, 2), ..., ct += rot(ct, D/2)
+       이후 각 블록의 첫 번째 슬롯에 해당 샘플의 점수가 모입니다.
+    3. 편향 b를 add_plain
+
+로지스틱 모델은 9_my_ckks.cpp와 같은 방식(제곱, 재선형화, rescale, 스케일 정규화)으로 sigmoid의 3차 근사
+    sigmoid(x) ~ 0.5 + 0.197x - 0.004x^3   (x in [-8, 8])
+를 평가합니다.
+*/
+namespace
+{
+    enum class Activation
+    {
+        none,
+        sigmoid
+    };
+
+    class BatchedModel
+    {
+    public:
+        BatchedModel(SEALSession &session, vector<double> weights, double bias, Activation activation, double scale)
+            : session_(session), weights_(move(weights)), bias_(bias), activation_(activation), scale_(scale)
+        {
+            auto &encoder = session_.ckks_encoder();
+            size_t slot_count = encoder.slot_count();
+            block_size_ = 1;
+            while (block_size_ < weights_.size())
+            {
+                block_size_ <<= 1;
+            }
+            if (block_size_ > slot_count)
+            {
+                throw invalid_argument("too many features for the slot count");
+            }
+            samples_per_ciphertext_ = slot_count / block_size_;
+
+            /*
+            가중치와 편향 평문은 한 번만 인코딩합니다. 가중치는 첫 번째 레벨, 편향은 가중합 rescale 후의 레벨입니다.
+            */
+            auto &context = session_.context();
+            parms_id_type first_parms_id = context.first_parms_id();
+            vector<double> repeated(slot_count, 0.0);
+            for (size_t s = 0; s < samples_per_ciphertext_; s++)
+            {
+                copy(weights_.begin(), weights_.end(), repeated.begin() + static_cast<ptrdiff_t>(s * block_size_));
+            }
+            encoder.encode(repeated, first_parms_id, scale_, plain_weights_);
+            parms_id_type second_parms_id = context.get_context_data(first_parms_id)->next_context_data()->parms_id();
+            encoder.encode(bias_, second_parms_id, scale_, plain_bias_);
+
+            vector<int> steps;
+            for (size_t k = 1; k < block_size_; k <<= 1)
+            {
+                steps.push_back(static_cast<int>(k));
+            }
+            galois_keys_ = &session_.galois_keys(steps);
+        }
+
+        size_t samples_per_ciphertext() const noexcept
+        {
+            return samples_per_ciphertext_;
+        }
+
+        void encrypt_batch(const vector<vector<double>> &samples, size_t begin, size_t end, Ciphertext &destination) const
+        {
+            auto &encoder = session_.ckks_encoder();
+            vector<double> packed(encoder.slot_count(), 0.0);
+            for (size_t s = begin; s < end; s++)
+            {
+                copy(samples[s].begin(), samples[s].end(),
+                     packed.begin() + static_cast<ptrdiff_t>((s - begin) * block_size_));
+            }
+            Plaintext plain;
+            encoder.encode(packed, scale_, plain);
+            session_.encryptor().encrypt(plain, destination);
+        }
+
+        void evaluate(Ciphertext &encrypted) const
+        {
+            auto &evaluator = session_.evaluator();
+            evaluator.multiply_plain_inplace(encrypted, plain_weights_);
+            evaluator.rescale_to_next_inplace(encrypted);
+            encrypted.scale() = scale_;
+
+            Ciphertext rotated;
+            for (size_t k = 1; k < block_size_; k <<= 1)
+            {
+                evaluator.rotate_vector(encrypted, static_cast<int>(k), *galois_keys_, rotated);
+                evaluator.add_inplace(encrypted, rotated);
+            }
+            evaluator.add_plain_inplace(encrypted, plain_bias_);
+
+            if (activation_ == Activation::sigmoid)
+            {
+                apply_sigmoid(encrypted);
+            }
+        }
+
+        vector<double> decrypt_scores(const Ciphertext &encrypted, size_t count) const
+        {
+            Plaintext plain;
+            session_.decryptor().decrypt(encrypted, plain);
+            vector<double> slots;
+            session_.ckks_encoder().decode(plain, slots);
+            vector<double> scores(count);
+            for (size_t s = 0; s < count; s++)
+            {
+                scores[s] = slots[s * block_size_];
+            }
+            return scores;
+        }
+
+        double reference(const vector<double> &sample) const
+        {
+            double z = bias_;
+            for (size_t k = 0; k < weights_.size(); k++)
+            {
+                z += weights_[k] * sample[k];
+            }
+            return activation_ == Activation::sigmoid ? 0.5 + 0.197 * z - 0.004 * z * z * z : z;
+        }
+
+    private:
+        void apply_sigmoid(Ciphertext &x) const
+        {
+            auto &evaluator = session_.evaluator();
+            auto &encoder = session_.ckks_encoder();
+            auto &relin_keys = session_.relin_keys();
+
+            Ciphertext x2;
+            evaluator.square(x, x2);
+            evaluator.relinearize_inplace(x2, relin_keys);
+            evaluator.rescale_to_next_inplace(x2);
+            x2.scale() = scale_;
+
+            Plaintext plain_coeff3, plain_coeff1, plain_coeff0;
+            encoder.encode(-0.004, x.parms_id(), scale_, plain_coeff3);
+            encoder.encode(0.197, x.parms_id(), scale_, plain_coeff1);
+
+            Ciphertext x_coeff3;
+            evaluator.multiply_plain(x, plain_coeff3, x_coeff3);
+            evaluator.rescale_to_next_inplace(x_coeff3);
+            x_coeff3.scale() = scale_;
+
+            evaluator.multiply_plain_inplace(x, plain_coeff1);
+            evaluator.rescale_to_next_inplace(x);
+            x.scale() = scale_;
+
+            evaluator.multiply_inplace(x2, x_coeff3);
+            evaluator.relinearize_inplace(x2, relin_keys);
+            evaluator.rescale_to_next_inplace(x2);
+            x2.scale() = scale_;
+
+            evaluator.mod_switch_to_inplace(x, x2.parms_id());
+            evaluator.add_inplace(x, x2);
+            encoder.encode(0.5, x.parms_id(), scale_, plain_coeff0);
+            evaluator.add_plain_inplace(x, plain_coeff0);
+        }
+
+        SEALSession &session_;
+
+        vector<double> weights_;
+
+        double bias_;
+
+        Activation activation_;
+
+        double scale_;
+
+        size_t block_size_ = 1;
+
+        size_t samples_per_ciphertext_ = 1;
+
+        Plaintext plain_weights_;
+
+        Plaintext plain_bias_;
+
+        const GaloisKeys *galois_keys_ = nullptr;
+    };
+} // namespace
+
+void example_inference()
+{
+    print_example_banner("Example: Batched Encrypted Inference");
+
+    EncryptionParameters parms(scheme_type::ckks);
+    size_t poly_modulus_degree = 16384;
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, 50, 50, 50, 50, 60 }));
+    double scale = pow(2.0, 50);
+
+    auto session = SEALSession::Get(parms);
+    print_parameters(session->context());
+    cout << endl;
+    session->relin_keys();
+
+    /*
+    d = 30개의 특성을 가진 로지스틱 회귀 모델과 무작위 데이터셋을 만듭니다.
+    */
+    size_t feature_count = 30;
+    size_t sample_count = 4096;
+    mt19937_64 engine(42);
+    normal_distribution<double> weight_dist(0.0, 0.3);
+    uniform_real_distribution<double> feature_dist(-1.0, 1.0);
+    vector<double> weights(feature_count);
+    for (auto &w : weights)
+    {
+        w = weight_dist(engine);
+    }
+    double bias = 0.1;
+    vector<vector<double>> samples(sample_count, vector<double>(feature_count));
+    for (auto &sample : samples)
+    {
+        for (auto &v : sample)
+        {
+            v = feature_dist(engine);
+        }
+    }
+
+    BatchedModel model(*session, weights, bias, Activation::sigmoid, scale);
+    size_t per_ciphertext = model.samples_per_ciphertext();
+    size_t batch_count = (sample_count + per_ciphertext - 1) / per_ciphertext;
+    print_line(__LINE__);
+    cout << "Logistic model with " << feature_count << " features, " << per_ciphertext
+         << " samples per ciphertext, " << batch_count << " ciphertexts for " << sample_count << " samples." << endl;
+
+    chrono::high_resolution_clock::time_point time_start, time_end;
+
+    /*
+    기준: 예제들처럼 샘플마다 암호문 하나를 사용합니다. 몇 개의 샘플만 실행하여 샘플당 시간을 추정합니다.
+    */
+    size_t baseline_count = 8;
+    time_start = chrono::high_resolution_clock::now();
+    for (size_t s = 0; s < baseline_count; s++)
+    {
+        Ciphertext encrypted;
+        model.encrypt_batch(samples, s, s + 1, encrypted);
+        model.evaluate(encrypted);
+    }
+    time_end = chrono::high_resolution_clock::now();
+    double baseline_seconds = chrono::duration<double>(time_end - time_start).count();
+    print_line(__LINE__);
+    cout << "One sample per ciphertext: " << baseline_count / baseline_seconds << " samples/s" << endl;
+
+    /*
+    배치 모드: 암호문 단위의 작업을 여러 스레드에 나눕니다. 세션의 Evaluator, Encryptor, 인코더는 상태가 없으므로
+    공유할 수 있습니다. 패킹의 효과와 스레드의 효과를 따로 보기 위해 먼저 스레드 하나로, 다음에 모든 코어로
+    실행합니다.
+    */
+    vector<Ciphertext> encrypted_batches(batch_count);
+    auto run_batched = [&](size_t thread_count) {
+        atomic<size_t> next_batch{ 0 };
+        auto start = chrono::high_resolution_clock::now();
+        vector<thread> threads;
+        for (size_t t = 0; t < thread_count; t++)
+        {
+            threads.emplace_back([&]() {
+                for (size_t b = next_batch++; b < batch_count; b = next_batch++)
+                {
+                    size_t begin = b * per_ciphertext;
+                    size_t end = min(sample_count, begin + per_ciphertext);
+                    model.encrypt_batch(samples, begin, end, encrypted_batches[b]);
+                    model.evaluate(encrypted_batches[b]);
+                }
+            });
+        }
+        for (auto &th : threads)
+        {
+            th.join();
+        }
+        return chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+    };
+
+    double baseline_rate = baseline_count / baseline_seconds;
+    double packed_rate = sample_count / run_batched(1);
+    print_line(__LINE__);
+    cout << "Batched (1 thread): " << packed_rate << " samples/s" << endl;
+    cout << "    + Packing gain over one sample per ciphertext: " << packed_rate / baseline_rate << "x" << endl;
+
+    size_t thread_count = max<size_t>(1, thread::hardware_concurrency());
+    double threaded_rate = sample_count / run_batched(thread_count);
+    print_line(__LINE__);
+    cout << "Batched (" << thread_count << " threads): " << threaded_rate << " samples/s" << endl;
+    cout << "    + Threading gain over 1 thread: " << threaded_rate / packed_rate << "x" << endl;
+    cout << "    + Combined gain over one sample per ciphertext: " << threaded_rate / baseline_rate << "x" << endl;
+
+    double error = 0;
+    vector<double> scores;
+    for (size_t b = 0; b < batch_count; b++)
+    {
+        size_t begin = b * per_ciphertext;
+        size_t end = min(sample_count, begin + per_ciphertext);
+        vector<double> batch_scores = model.decrypt_scores(encrypted_batches[b], end - begin);
+        for (size_t s = begin; s < end; s++)
+        {
+            error = max(error, fabs(batch_scores[s - begin] - model.reference(samples[s])));
+        }
+        scores.insert(scores.end(), batch_scores.begin(), batch_scores.end());
+    }
+    cout << "    + Max error against plaintext model: " << error << endl;
+    cout << "    + Scores:" << endl;
+    print_vector(scores, 3, 7);
+}
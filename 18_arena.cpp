@@ -0,0 +1,302 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+
+using namespace std;
+using namespace seal;
+
+/*
+example_my_ckks()의 회로는 실행할 때마다 x2_encrypted, x_plus_one_sq, encrypted_result, rotated 같은 임시
+암호문을 새로 만들고, encrypted_result = x2_encrypted는 수 MB의 다항식을 깊은 복사합니다.
+
+CiphertextArena는 임시 암호문의 버퍼를 재사용합니다.
+    - 모든 버퍼는 첫 번째 레벨에서 크기 3(곱셈 직후)의 용량으로 예약됩니다. SEAL의 Ciphertext::resize는 용량
+      안에서는 재할당하지 않으므로, 같은 버퍼를 어떤 레벨의 어떤 연산 결과에도 다시 쓸 수 있습니다.
+    - acquire()는 반납된 버퍼를 돌려주고, release()는 암호문을 move로 돌려받습니다.
+    - 아레나는 자신의 MemoryPoolHandle을 가지며 Evaluator 호출의 임시 메모리도 이 풀에서 가져오므로, 정상 상태의
+      반복에서는 이 풀의 할당량이 늘지 않습니다.
+*/
+namespace
+{
+    class CiphertextArena
+    {
+    public:
+        explicit CiphertextArena(const SEALContext &context, size_t size_capacity = 3)
+            : context_(context), size_capacity_(size_capacity), pool_(MemoryPoolHandle::New())
+        {
+        }
+
+        Ciphertext acquire()
+        {
+            if (free_.empty())
+            {
+                created_count_++;
+                return Ciphertext(context_, context_.first_parms_id(), size_capacity_, pool_);
+            }
+            Ciphertext encrypted = move(free_.back());
+            free_.pop_back();
+            return encrypted;
+        }
+
+        /*
+        아레나가 만든 버퍼만 돌려받습니다. 다른 풀의 버퍼나 용량이 작은 버퍼가 섞이면 다음 acquire가 돌려준 버퍼가
+        재할당되어 정상 상태에서 할당이 없다는 보장이 깨지므로 예외를 던집니다. 용량은 레벨에 따라 달라지는
+        size_capacity() 대신 바이트 용량으로 비교합니다.
+        */
+        void release(Ciphertext &&encrypted)
+        {
+            if (encrypted.pool() != pool_)
+            {
+                throw invalid_argument("encrypted was not allocated from the arena pool");
+            }
+            if (encrypted.dyn_array().capacity() < buffer_capacity())
+            {
+                throw invalid_argument("encrypted has a smaller capacity than the arena buffers");
+            }
+            free_.push_back(move(encrypted));
+        }
+
+        const MemoryPoolHandle &pool() const noexcept
+        {
+            return pool_;
+        }
+
+        size_t created_count() const noexcept
+        {
+            return created_count_;
+        }
+
+        size_t free_count() const noexcept
+        {
+            return free_.size();
+        }
+
+    private:
+        size_t buffer_capacity() const
+        {
+            auto &parms = context_.first_context_data()->parms();
+            return size_capacity_ * parms.poly_modulus_degree() * parms.coeff_modulus().size();
+        }
+
+        const SEALContext &context_;
+
+        size_t size_capacity_;
+
+        MemoryPoolHandle pool_;
+
+        vector<Ciphertext> free_;
+
+        size_t created_count_ = 0;
+    };
+
+    struct CircuitConstants
+    {
+        Plaintext one;
+        Plaintext two;
+    };
+
+    /*
+    회로 한 번이 새로 만든 암호문 버퍼와 깊은 복사(다항식 데이터 전체의 복사)의 횟수입니다.
+    */
+    struct CircuitCounts
+    {
+        size_t buffers_created = 0;
+        size_t deep_copies = 0;
+    };
+
+    /*
+    9_my_ckks.cpp와 같은 방식으로 매 반복마다 임시 암호문을 새로 만드는 구현입니다. 아레나와 같은 방식으로
+    측정하기 위해 임시 암호문과 Evaluator의 임시 메모리는 모두 pool에서 가져옵니다.
+    */
+    void circuit_fresh(
+        SEALSession &session, const MemoryPoolHandle &pool, const Ciphertext &x1_encrypted,
+        const CircuitConstants &constants, double scale, Ciphertext &rotated, CircuitCounts &counts)
+    {
+        auto &evaluator = session.evaluator();
+        auto &relin_keys = session.relin_keys();
+        auto &galois_keys = session.galois_keys();
+
+        Ciphertext x2_encrypted(pool);
+        counts.buffers_created++;
+        evaluator.square(x1_encrypted, x2_encrypted, pool);
+        evaluator.relinearize_inplace(x2_encrypted, relin_keys, pool);
+        evaluator.rescale_to_next_inplace(x2_encrypted, pool);
+        x2_encrypted.scale() = scale;
+        evaluator.add_plain_inplace(x2_encrypted, constants.two);
+
+        Ciphertext x_plus_one(pool);
+        x_plus_one = x1_encrypted;
+        counts.buffers_created++;
+        counts.deep_copies++;
+        evaluator.add_plain_inplace(x_plus_one, constants.one);
+        Ciphertext x_plus_one_sq(pool);
+        counts.buffers_created++;
+        evaluator.square(x_plus_one, x_plus_one_sq, pool);
+        evaluator.relinearize_inplace(x_plus_one_sq, relin_keys, pool);
+        evaluator.rescale_to_next_inplace(x_plus_one_sq, pool);
+        x_plus_one_sq.scale() = scale;
+
+        Ciphertext encrypted_result(pool);
+        counts.buffers_created++;
+        evaluator.multiply_inplace(x2_encrypted, x_plus_one_sq, pool);
+        encrypted_result = x2_encrypted;
+        counts.deep_copies++;
+        evaluator.relinearize_inplace(encrypted_result, relin_keys, pool);
+        evaluator.rescale_to_next_inplace(encrypted_result, pool);
+
+        evaluator.rotate_vector(encrypted_result, 2, galois_keys, rotated, pool);
+    }
+
+    /*
+    같은 회로를 아레나의 버퍼로 평가합니다. 임시 암호문은 acquire로 받고, 복사 대신 move로 넘기고, 끝나면 release로
+    돌려줍니다. 결과를 담은 rotated도 아레나에서 받은 버퍼이며 호출자가 다 쓴 뒤 돌려줍니다.
+    */
+    void circuit_arena(
+        SEALSession &session, CiphertextArena &arena, const Ciphertext &x1_encrypted,
+        const CircuitConstants &constants, double scale, Ciphertext &rotated, CircuitCounts &counts)
+    {
+        auto &evaluator = session.evaluator();
+        auto &relin_keys = session.relin_keys();
+        auto &galois_keys = session.galois_keys();
+        auto &pool = arena.pool();
+        size_t created_before = arena.created_count();
+
+        Ciphertext x2_encrypted = arena.acquire();
+        evaluator.square(x1_encrypted, x2_encrypted, pool);
+        evaluator.relinearize_inplace(x2_encrypted, relin_keys, pool);
+        evaluator.rescale_to_next_inplace(x2_encrypted, pool);
+        x2_encrypted.scale() = scale;
+        evaluator.add_plain_inplace(x2_encrypted, constants.two);
+
+        Ciphertext x_plus_one_sq = arena.acquire();
+        x_plus_one_sq = x1_encrypted;
+        counts.deep_copies++;
+        evaluator.add_plain_inplace(x_plus_one_sq, constants.one);
+        evaluator.square_inplace(x_plus_one_sq, pool);
+        evaluator.relinearize_inplace(x_plus_one_sq, relin_keys, pool);
+        evaluator.rescale_to_next_inplace(x_plus_one_sq, pool);
+        x_plus_one_sq.scale() = scale;
+
+        evaluator.multiply_inplace(x2_encrypted, x_plus_one_sq, pool);
+        arena.release(move(x_plus_one_sq));
+        Ciphertext encrypted_result = move(x2_encrypted);
+        evaluator.relinearize_inplace(encrypted_result, relin_keys, pool);
+        evaluator.rescale_to_next_inplace(encrypted_result, pool);
+
+        evaluator.rotate_vector(encrypted_result, 2, galois_keys, rotated, pool);
+        arena.release(move(encrypted_result));
+        counts.buffers_created += arena.created_count() - created_before;
+    }
+} // namespace
+
+void example_arena()
+{
+    print_example_banner("Example: Ciphertext Arena");
+
+    EncryptionParameters parms(scheme_type::ckks);
+    size_t poly_modulus_degree = 16384;
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, 50, 50, 50, 50, 60 }));
+    double scale = pow(2.0, 50);
+
+    auto session = SEALSession::Get(parms);
+    const SEALContext &context = session->context();
+    print_parameters(context);
+    cout << endl;
+
+    auto &encoder = session->ckks_encoder();
+    auto &encryptor = session->encryptor();
+    auto &decryptor = session->decryptor();
+    session->relin_keys();
+    session->galois_keys();
+    size_t slot_count = encoder.slot_count();
+
+    vector<double> input(slot_count);
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        input[i] = static_cast<double>(i) / static_cast<double>(slot_count - 1);
+    }
+    Plaintext x_plain;
+    encoder.encode(input, scale, x_plain);
+    Ciphertext x1_encrypted;
+    encryptor.encrypt(x_plain, x1_encrypted);
+
+    /*
+    상수 평문은 반복 밖에서 필요한 레벨로 한 번만 인코딩합니다.
+    */
+    CircuitConstants constants;
+    encoder.encode(1.0, x1_encrypted.parms_id(), scale, constants.one);
+    parms_id_type second_parms_id = context.get_context_data(x1_encrypted.parms_id())->next_context_data()->parms_id();
+    encoder.encode(2.0, second_parms_id, scale, constants.two);
+
+    /*
+    두 경로 모두 전용 풀을 쓰고, 한 번의 워밍업 반복 뒤부터 같은 방식으로 잽니다. 워밍업 반복에서는 어느 쪽이든 풀이
+    필요한 만큼 커지고 SEAL의 풀은 해제된 메모리를 다시 쓰므로, 정상 상태에서의 차이는 풀의 크기가 아니라 새로
+    만드는 버퍼와 깊은 복사의 횟수에서 나타납니다.
+    */
+    size_t iterations = 20;
+    chrono::high_resolution_clock::time_point time_start, time_end;
+    Ciphertext rotated;
+    CircuitCounts warmup_counts;
+
+    print_line(__LINE__);
+    cout << "Fresh temporaries, " << iterations << " iterations after one warm-up." << endl;
+    MemoryPoolHandle fresh_pool = MemoryPoolHandle::New();
+    circuit_fresh(*session, fresh_pool, x1_encrypted, constants, scale, rotated, warmup_counts);
+    size_t fresh_before = fresh_pool.alloc_byte_count();
+    CircuitCounts fresh_counts;
+    time_start = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        circuit_fresh(*session, fresh_pool, x1_encrypted, constants, scale, rotated, fresh_counts);
+    }
+    time_end = chrono::high_resolution_clock::now();
+    cout << "    + " << chrono::duration_cast<chrono::microseconds>(time_end - time_start).count() / iterations
+         << " microseconds per iteration" << endl;
+    cout << "    + Ciphertext buffers created per iteration: " << fresh_counts.buffers_created / iterations
+         << ", deep copies per iteration: " << fresh_counts.deep_copies / iterations << endl;
+    cout << "    + Pool growth after warm-up: " << ((fresh_pool.alloc_byte_count() - fresh_before) >> 20) << " MB"
+         << endl;
+
+    print_line(__LINE__);
+    cout << "Arena temporaries, " << iterations << " iterations after one warm-up." << endl;
+    CiphertextArena arena(context);
+    auto run_arena = [&](bool keep, CircuitCounts &counts) {
+        Ciphertext result = arena.acquire();
+        circuit_arena(*session, arena, x1_encrypted, constants, scale, result, counts);
+        if (keep)
+        {
+            rotated = move(result);
+        }
+        else
+        {
+            arena.release(move(result));
+        }
+    };
+    run_arena(false, warmup_counts);
+    size_t arena_before = arena.pool().alloc_byte_count();
+    CircuitCounts arena_counts;
+    time_start = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        run_arena(i + 1 == iterations, arena_counts);
+    }
+    time_end = chrono::high_resolution_clock::now();
+    cout << "    + " << chrono::duration_cast<chrono::microseconds>(time_end - time_start).count() / iterations
+         << " microseconds per iteration" << endl;
+    cout << "    + Ciphertext buffers created per iteration: " << arena_counts.buffers_created / iterations
+         << ", deep copies per iteration: " << arena_counts.deep_copies / iterations << endl;
+    cout << "    + Pool growth after warm-up: " << ((arena.pool().alloc_byte_count() - arena_before) >> 20) << " MB"
+         << endl;
+    cout << "    + Buffers and deep copies avoided over " << iterations
+         << " iterations: " << fresh_counts.buffers_created - arena_counts.buffers_created << " and "
+         << fresh_counts.deep_copies - arena_counts.deep_copies << endl;
+
+    Plaintext plain_result;
+    decryptor.decrypt(rotated, plain_result);
+    vector<double> result;
+    encoder.decode(plain_result, result);
+    cout << "    + Result of the last iteration:" << endl;
+    print_vector(result, 3, 7);
+}
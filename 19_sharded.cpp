@@ -0,0 +1,342 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace seal;
+
+/*
+하나의 프로세스와 하나의 Evaluator로는 큰 NUMA 서버를 충분히 활용하기 어렵습니다. 이 예제는 N개의 워커 프로세스를
+fork하여 암호화된 데이터셋 파일을 나누어 처리하고 결과를 합칩니다.
+
+    - 재선형화 키와 Galois 키는 부모 프로세스에서 한 번만 만듭니다. 워커는 fork로 부모의 메모리를 copy-on-write로
+      물려받고 키를 읽기만 하므로, 키 페이지는 복사되지 않고 모든 워커가 같은 물리 메모리를 공유합니다. 키를 파일로
+      내보내 mmap할 필요는 없습니다. SEAL의 키 객체는 자신의 메모리를 소유하므로 어차피 mmap된 바이트를 복사해야
+      하기 때문입니다.
+    - 데이터셋은 mmap하며, 각 워커는 자신의 구간에 있는 암호문만 로드합니다.
+    - 각 워커는 sched_setaffinity로 코어 그룹에 고정됩니다. 코어 그룹은 sched_getaffinity가 돌려준, 이 프로세스가
+      실제로 쓸 수 있는 CPU 번호를 나누어 만듭니다(taskset이나 cgroup 아래에서는 번호가 0부터 연속이 아닙니다).
+      워커가 할당하는 임시 메모리는 first-touch 정책에 따라 그 코어가 속한 NUMA 노드에 놓입니다.
+    - 워커의 결과는 워커별 파일에 쓰고, 부모가 모든 워커를 기다린 뒤 읽어서 합칩니다.
+*/
+#ifdef __linux__
+namespace
+{
+    /*
+    데이터셋 파일 형식: [개수 n][오프셋 n + 1개][암호문 n개]. 오프셋이 있으므로 워커는 자신의 구간으로 바로 갑니다.
+    */
+    void write_dataset(const string &path, const vector<Ciphertext> &dataset)
+    {
+        ofstream stream(path, ios::binary | ios::trunc);
+        write_uint64(stream, dataset.size());
+        streamoff header_end = static_cast<streamoff>(sizeof(uint64_t) * (dataset.size() + 2));
+        vector<uint64_t> offsets;
+        stream.seekp(header_end);
+        for (auto &encrypted : dataset)
+        {
+            offsets.push_back(static_cast<uint64_t>(stream.tellp()));
+            encrypted.save(stream, compr_mode_type::none);
+        }
+        offsets.push_back(static_cast<uint64_t>(stream.tellp()));
+        stream.seekp(sizeof(uint64_t));
+        for (auto offset : offsets)
+        {
+            write_uint64(stream, offset);
+        }
+        stream.close();
+        if (!stream)
+        {
+            throw runtime_error("cannot write " + path);
+        }
+    }
+
+    /*
+    이 프로세스가 실행될 수 있는 CPU 번호들입니다. sched_getaffinity가 실패하면 빈 목록을 돌려줍니다.
+    */
+    vector<int> allowed_cpus()
+    {
+        vector<int> cpus;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) != 0)
+        {
+            return cpus;
+        }
+        for (int c = 0; c < CPU_SETSIZE; c++)
+        {
+            if (CPU_ISSET(c, &set))
+            {
+                cpus.push_back(c);
+            }
+        }
+        return cpus;
+    }
+
+    bool pin_to_cpus(const vector<int> &cpus)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int c : cpus)
+        {
+            CPU_SET(c, &set);
+        }
+        return sched_setaffinity(0, sizeof(set), &set) == 0;
+    }
+
+    /*
+    워커의 작업: x^2를 계산하고 처음 8개 슬롯을 rotate-and-sum합니다.
+    */
+    void process_ciphertext(SEALSession &session, const RelinKeys &relin_keys, const GaloisKeys &galois_keys,
+                            Ciphertext &encrypted)
+    {
+        auto &evaluator = session.evaluator();
+        evaluator.square_inplace(encrypted);
+        evaluator.relinearize_inplace(encrypted, relin_keys);
+        evaluator.rescale_to_next_inplace(encrypted);
+        Ciphertext rotated;
+        for (int step = 1; step < 8; step <<= 1)
+        {
+            evaluator.rotate_vector(encrypted, step, galois_keys, rotated);
+            evaluator.add_inplace(encrypted, rotated);
+        }
+    }
+
+    int run_worker(
+        SEALSession &session, const RelinKeys &relin_keys, const GaloisKeys &galois_keys, const MappedFile &dataset,
+        size_t begin, size_t end, const string &result_path)
+    {
+        ofstream stream(result_path, ios::binary | ios::trunc);
+        write_uint64(stream, end - begin);
+        Ciphertext encrypted;
+        for (size_t i = begin; i < end; i++)
+        {
+            size_t offset = static_cast<size_t>(dataset.read_uint64(sizeof(uint64_t) * (i + 1)));
+            size_t next = static_cast<size_t>(dataset.read_uint64(sizeof(uint64_t) * (i + 2)));
+            encrypted.load(session.context(), dataset.data() + offset, next - offset);
+            process_ciphertext(session, relin_keys, galois_keys, encrypted);
+            encrypted.save(stream, compr_mode_type::none);
+        }
+        stream.close();
+        return stream ? 0 : 1;
+    }
+} // namespace
+#endif
+
+void example_sharded()
+{
+    print_example_banner("Example: Multi-Process Sharded Evaluation");
+
+#ifndef __linux__
+    cout << "This example requires fork, mmap and sched_setaffinity (Linux)." << endl;
+#else
+    EncryptionParameters parms(scheme_type::ckks);
+    size_t poly_modulus_degree = 16384;
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, 50, 50, 50, 50, 60 }));
+    double scale = pow(2.0, 50);
+
+    auto session = SEALSession::Get(parms);
+    const SEALContext &context = session->context();
+    print_parameters(context);
+    cout << endl;
+
+    auto &encoder = session->ckks_encoder();
+    auto &encryptor = session->encryptor();
+    auto &decryptor = session->decryptor();
+    auto &evaluator = session->evaluator();
+    size_t slot_count = encoder.slot_count();
+
+    string dataset_path = "sharded_dataset.bin";
+
+    /*
+    키는 fork 전에 부모 프로세스에서 만들어 두고, 워커들은 copy-on-write로 공유합니다.
+    */
+    print_line(__LINE__);
+    cout << "Generate keys once in the parent process." << endl;
+    const RelinKeys &relin_keys = session->relin_keys();
+    const GaloisKeys &galois_keys = session->galois_keys();
+    cout << "    + Keys: "
+         << ((relin_keys.save_size(compr_mode_type::none) + galois_keys.save_size(compr_mode_type::none)) >> 20)
+         << " MB, shared copy-on-write by all workers" << endl;
+
+    /*
+    암호화된 데이터셋을 만듭니다.
+    */
+    size_t dataset_size = 64;
+    print_line(__LINE__);
+    cout << "Encrypt a dataset of " << dataset_size << " ciphertexts to " << dataset_path << "." << endl;
+    vector<Ciphertext> dataset(dataset_size);
+    vector<double> expected(slot_count, 0.0);
+    Plaintext plain;
+    for (size_t d = 0; d < dataset_size; d++)
+    {
+        vector<double> values(slot_count);
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            values[i] = static_cast<double>((i + d) % 16) / 16.0;
+        }
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            for (size_t k = 0; k < 8; k++)
+            {
+                double v = values[(i + k) % slot_count];
+                expected[i] += v * v;
+            }
+        }
+        encoder.encode(values, scale, plain);
+        encryptor.encrypt(plain, dataset[d]);
+    }
+    write_dataset(dataset_path, dataset);
+    dataset.clear();
+    MappedFile dataset_file(dataset_path);
+
+    print_line(__LINE__);
+    vector<int> cpus = allowed_cpus();
+    if (cpus.empty())
+    {
+        cout << "sched_getaffinity failed (" << strerror(errno) << "); workers run unpinned." << endl;
+    }
+    else
+    {
+        cout << "This process may run on " << cpus.size() << " CPU(s)." << endl;
+    }
+    size_t core_count = cpus.empty() ? max<size_t>(1, thread::hardware_concurrency()) : cpus.size();
+    vector<size_t> worker_counts;
+    for (size_t w = 1; w <= core_count; w <<= 1)
+    {
+        worker_counts.push_back(w);
+    }
+
+    for (size_t worker_count : worker_counts)
+    {
+        print_line(__LINE__);
+        cout << "Run with " << worker_count << " worker process(es)." << endl;
+
+        /*
+        허용된 CPU들을 워커 수만큼의 연속된 구간으로 나눕니다. worker_count <= cpus.size()이므로 빈 그룹은 없습니다.
+        */
+        vector<vector<int>> core_groups;
+        for (size_t w = 0; w < worker_count && !cpus.empty(); w++)
+        {
+            core_groups.emplace_back(
+                cpus.begin() + static_cast<ptrdiff_t>(cpus.size() * w / worker_count),
+                cpus.begin() + static_cast<ptrdiff_t>(cpus.size() * (w + 1) / worker_count));
+        }
+
+        /*
+        fork 전에 모든 스레드가 끝나 있어야 합니다(메모리 풀의 잠금이 복제되기 때문입니다).
+        */
+        cout.flush();
+        auto time_start = chrono::high_resolution_clock::now();
+        vector<pid_t> workers;
+        for (size_t w = 0; w < worker_count; w++)
+        {
+            size_t begin = dataset_size * w / worker_count;
+            size_t end = dataset_size * (w + 1) / worker_count;
+            string result_path = "sharded_result_" + to_string(w) + ".bin";
+            pid_t pid = fork();
+            if (pid == 0)
+            {
+                int status = 1;
+                try
+                {
+                    if (!core_groups.empty() && !pin_to_cpus(core_groups[w]))
+                    {
+                        cerr << "    + Worker " << w << ": sched_setaffinity failed (" << strerror(errno)
+                             << "), running unpinned" << endl;
+                    }
+                    status =
+                        run_worker(*session, relin_keys, galois_keys, dataset_file, begin, end, result_path);
+                }
+                catch (...)
+                {
+                    status = 1;
+                }
+                _exit(status);
+            }
+            if (pid < 0)
+            {
+                cout << "    + fork failed" << endl;
+                break;
+            }
+            workers.push_back(pid);
+        }
+
+        vector<bool> succeeded;
+        for (auto pid : workers)
+        {
+            int status = 0;
+            pid_t waited;
+            do
+            {
+                waited = waitpid(pid, &status, 0);
+            } while (waited < 0 && errno == EINTR);
+            succeeded.push_back(waited == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        }
+        auto time_end = chrono::high_resolution_clock::now();
+        double seconds = chrono::duration<double>(time_end - time_start).count();
+
+        /*
+        워커별 결과 파일을 읽어 하나의 암호문으로 합칩니다. 파일 맨 앞의 개수는 암호문보다 먼저 쓰이므로, 도중에
+        실패한 워커의 파일은 개수만큼의 암호문을 담고 있지 않습니다. 따라서 정상 종료한 워커의 파일만 읽고, 그
+        경우에도 읽기 실패를 워커의 실패로 처리합니다.
+        */
+        vector<Ciphertext> results;
+        bool ok = workers.size() == worker_count;
+        for (size_t w = 0; w < workers.size(); w++)
+        {
+            string result_path = "sharded_result_" + to_string(w) + ".bin";
+            if (succeeded[w])
+            {
+                try
+                {
+                    ifstream stream(result_path, ios::binary);
+                    uint64_t count = 0;
+                    stream.read(reinterpret_cast<char *>(&count), sizeof(count));
+                    for (uint64_t i = 0; i < count; i++)
+                    {
+                        Ciphertext encrypted;
+                        encrypted.load(context, stream);
+                        results.push_back(move(encrypted));
+                    }
+                }
+                catch (const exception &e)
+                {
+                    cout << "    + Worker " << w << ": cannot load results (" << e.what() << ")" << endl;
+                    succeeded[w] = false;
+                }
+            }
+            else
+            {
+                cout << "    + Worker " << w << " failed" << endl;
+            }
+            ok = ok && succeeded[w];
+            std::remove(result_path.c_str());
+        }
+
+        cout << "    + Workers succeeded: " << (ok ? "yes" : "no") << ", results merged: " << results.size() << endl;
+        cout << "    + Throughput: " << dataset_size / seconds << " ciphertexts/s" << endl;
+        if (ok && results.size() == dataset_size)
+        {
+            Ciphertext merged;
+            evaluator.add_many(results, merged);
+            decryptor.decrypt(merged, plain);
+            vector<double> decoded;
+            encoder.decode(plain, decoded);
+            cout << "    + Max error of merged result: " << max_abs_error(expected, decoded) << endl;
+        }
+    }
+
+    std::remove(dataset_path.c_str());
+#endif
+}
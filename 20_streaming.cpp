@@ -0,0 +1,415 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+#include <deque>
+
+using namespace std;
+using namespace seal;
+
+/*
+연속적으로 들어오는 암호화된 배치(슬롯마다 센서 하나)에 대한 상태 유지 누산기입니다. 각 누산기는 새 배치를
+기존 암호문에 접어 넣으므로 이벤트당 비용이 윈도우 크기와 무관한 O(1)입니다. 누산기는 스케일과 레벨을 직접
+관리하여 상태가 레벨을 잃지 않고 계속 사용 가능하도록 합니다.
+
+    - 누적 합: add_inplace만 사용하므로 상태는 첫 번째 레벨에 머뭅니다.
+    - 누적 평균: 합 암호문의 스케일에 count를 곱한 복사본을 돌려줍니다. CKKS의 값은 (메시지 / 스케일)이므로
+      스케일을 바꾸는 것은 레벨을 쓰지 않는 상수 나눗셈입니다.
+    - 텀블링 윈도우: 윈도우가 닫힐 때 합을 내보내고 초기화합니다.
+    - 슬라이딩 윈도우: 최근 W개의 배치를 링 버퍼에 두고 sum += new - oldest로 갱신합니다.
+    - 지수 이동 평균(EMA): s_t = (1 - a) s_{t-1} + a x_t. 상태에 (1 - a)를 곱할 때마다 rescale하면 레벨이 금방
+      바닥나므로, 곱셈 대신 스케일을 S / (1 - a)로 바꿉니다(레벨 소비 없음). 새 배치는 a를 담은 평문과 곱한 뒤
+      rescale하여 정확히 같은 스케일에 맞춥니다. 스케일이 끝없이 커지는 것을 막기 위해 시작 시점이 W만큼
+      어긋난 두 개의 pane을 유지하고, 나이가 2W가 된 pane은 새로 시작합니다. (1 - a)^W < 2^-precision_bits가
+      되도록 W를 고르면, 나이가 W 이상인 pane은 잘린 오래된 항에 의한 오차가 2^-precision_bits 이하입니다.
+*/
+namespace
+{
+    class RunningSum
+    {
+    public:
+        explicit RunningSum(SEALSession &session) : session_(session)
+        {
+        }
+
+        void update(const Ciphertext &batch)
+        {
+            if (count_ == 0)
+            {
+                sum_ = batch;
+            }
+            else
+            {
+                session_.evaluator().add_inplace(sum_, batch);
+            }
+            count_++;
+        }
+
+        const Ciphertext &sum() const noexcept
+        {
+            return sum_;
+        }
+
+        Ciphertext mean() const
+        {
+            Ciphertext mean = sum_;
+            mean.scale() *= static_cast<double>(count_);
+            return mean;
+        }
+
+        size_t count() const noexcept
+        {
+            return count_;
+        }
+
+        void reset() noexcept
+        {
+            count_ = 0;
+        }
+
+    private:
+        SEALSession &session_;
+
+        Ciphertext sum_;
+
+        size_t count_ = 0;
+    };
+
+    class TumblingWindowSum
+    {
+    public:
+        TumblingWindowSum(SEALSession &session, size_t window) : sum_(session), window_(window)
+        {
+            if (window == 0)
+            {
+                throw invalid_argument("window must be positive");
+            }
+        }
+
+        /*
+        윈도우가 닫히면 true를 돌려주고 closed에 그 윈도우의 합을 담습니다.
+        */
+        bool update(const Ciphertext &batch, Ciphertext &closed)
+        {
+            sum_.update(batch);
+            if (sum_.count() < window_)
+            {
+                return false;
+            }
+            closed = sum_.sum();
+            sum_.reset();
+            return true;
+        }
+
+    private:
+        RunningSum sum_;
+
+        size_t window_;
+    };
+
+    class SlidingWindowSum
+    {
+    public:
+        SlidingWindowSum(SEALSession &session, size_t window) : session_(session), window_(window)
+        {
+            if (window == 0)
+            {
+                throw invalid_argument("window must be positive");
+            }
+        }
+
+        void update(const Ciphertext &batch)
+        {
+            auto &evaluator = session_.evaluator();
+            if (recent_.empty())
+            {
+                sum_ = batch;
+            }
+            else
+            {
+                evaluator.add_inplace(sum_, batch);
+            }
+            recent_.push_back(batch);
+            if (recent_.size() > window_)
+            {
+                evaluator.sub_inplace(sum_, recent_.front());
+                recent_.pop_front();
+            }
+        }
+
+        const Ciphertext &sum() const noexcept
+        {
+            return sum_;
+        }
+
+        Ciphertext mean() const
+        {
+            Ciphertext mean = sum_;
+            mean.scale() *= static_cast<double>(recent_.size());
+            return mean;
+        }
+
+    private:
+        SEALSession &session_;
+
+        size_t window_;
+
+        Ciphertext sum_;
+
+        deque<Ciphertext> recent_;
+    };
+
+    class ExponentialMovingAverage
+    {
+    public:
+        ExponentialMovingAverage(SEALSession &session, double alpha, int precision_bits = 30)
+            : session_(session), alpha_(alpha)
+        {
+            if (alpha <= 0 || alpha >= 1)
+            {
+                throw invalid_argument("alpha must be in (0, 1)");
+            }
+            window_ = static_cast<size_t>(ceil(precision_bits / -log2(1 - alpha)));
+        }
+
+        size_t window() const noexcept
+        {
+            return window_;
+        }
+
+        /*
+        batch는 첫 번째 레벨의 새 암호문이어야 합니다.
+        */
+        void update(const Ciphertext &batch)
+        {
+            if (time_ == 0)
+            {
+                panes_[0].age = 0;
+            }
+            if (time_ == window_)
+            {
+                panes_[1].age = 0;
+            }
+            for (auto &pane : panes_)
+            {
+                if (pane.age == never_started)
+                {
+                    continue;
+                }
+                if (pane.age == 2 * window_)
+                {
+                    pane.age = 0;
+                }
+                fold(pane, batch);
+            }
+            time_++;
+        }
+
+        /*
+        가장 오래된 pane이 EMA의 근사입니다. 스트림이 시작된 지 W보다 짧으면 pane 0이 정확한 값을 가집니다.
+        */
+        const Ciphertext &value() const
+        {
+            const Pane *oldest = &panes_[0];
+            for (auto &pane : panes_)
+            {
+                if (pane.age != never_started && (oldest->age == never_started || pane.age > oldest->age))
+                {
+                    oldest = &pane;
+                }
+            }
+            return oldest->state;
+        }
+
+    private:
+        static constexpr size_t never_started = numeric_limits<size_t>::max();
+
+        struct Pane
+        {
+            Ciphertext state;
+            size_t age = never_started;
+        };
+
+        void fold(Pane &pane, const Ciphertext &batch)
+        {
+            auto &context = session_.context();
+            auto &evaluator = session_.evaluator();
+            auto &encoder = session_.ckks_encoder();
+
+            /*
+            rescale은 현재 레벨의 마지막 소수 q로 나누므로, a를 스케일 target * q / batch.scale()로 인코딩하면 rescale
+            후의 스케일이 정확히 target이 됩니다.
+            */
+            auto batch_context_data = context.get_context_data(batch.parms_id());
+            double q = static_cast<double>(batch_context_data->parms().coeff_modulus().back().value());
+            double target;
+            if (pane.age == 0)
+            {
+                target = batch.scale();
+            }
+            else
+            {
+                pane.state.scale() /= (1 - alpha_);
+                target = pane.state.scale();
+            }
+
+            Plaintext plain_alpha;
+            encoder.encode(alpha_, batch.parms_id(), target * q / batch.scale(), plain_alpha);
+            Ciphertext weighted;
+            evaluator.multiply_plain(batch, plain_alpha, weighted);
+            evaluator.rescale_to_next_inplace(weighted);
+            weighted.scale() = target;
+
+            if (pane.age == 0)
+            {
+                pane.state = move(weighted);
+            }
+            else
+            {
+                evaluator.add_inplace(pane.state, weighted);
+            }
+            pane.age++;
+        }
+
+        SEALSession &session_;
+
+        double alpha_;
+
+        size_t window_ = 1;
+
+        size_t time_ = 0;
+
+        Pane panes_[2];
+    };
+} // namespace
+
+void example_streaming()
+{
+    print_example_banner("Example: Streaming Encrypted Aggregates");
+
+    EncryptionParameters parms(scheme_type::ckks);
+    size_t poly_modulus_degree = 16384;
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, 50, 50, 50, 50, 60 }));
+    double scale = pow(2.0, 50);
+
+    auto session = SEALSession::Get(parms);
+    print_parameters(session->context());
+    cout << endl;
+
+    auto &encoder = session->ckks_encoder();
+    auto &encryptor = session->encryptor();
+    auto &decryptor = session->decryptor();
+    size_t slot_count = encoder.slot_count();
+
+    size_t sliding_window = 16;
+    size_t tumbling_window = 32;
+    double alpha = 0.2;
+
+    RunningSum running(*session);
+    TumblingWindowSum tumbling(*session, tumbling_window);
+    SlidingWindowSum sliding(*session, sliding_window);
+    ExponentialMovingAverage ema(*session, alpha);
+
+    /*
+    평문 참조 값입니다.
+    */
+    vector<double> ref_sum(slot_count, 0.0), ref_tumbling(slot_count, 0.0), ref_ema(slot_count, 0.0);
+    vector<double> ref_closed(slot_count, 0.0);
+    deque<vector<double>> ref_recent;
+
+    auto decrypt = [&](const Ciphertext &encrypted) {
+        Plaintext plain;
+        decryptor.decrypt(encrypted, plain);
+        vector<double> decoded;
+        encoder.decode(plain, decoded);
+        return decoded;
+    };
+
+    print_line(__LINE__);
+    cout << "Stream " << 4 * ema.window() << " encrypted batches (EMA alpha " << alpha << ", pane window "
+         << ema.window() << ", sliding window " << sliding_window << ", tumbling window " << tumbling_window << ")."
+         << endl;
+
+    size_t event_count = 4 * ema.window();
+    size_t report_every = event_count / 4;
+    mt19937_64 engine(1);
+    normal_distribution<double> noise(0.0, 0.1);
+    chrono::microseconds update_time(0);
+    Ciphertext closed;
+    bool have_closed = false;
+    for (size_t t = 0; t < event_count; t++)
+    {
+        vector<double> batch(slot_count);
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            batch[i] = sin(static_cast<double>(t) / 20.0 + static_cast<double>(i % 64)) + noise(engine);
+        }
+        Plaintext plain;
+        encoder.encode(batch, scale, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        auto time_start = chrono::high_resolution_clock::now();
+        running.update(encrypted);
+        if (tumbling.update(encrypted, closed))
+        {
+            have_closed = true;
+        }
+        sliding.update(encrypted);
+        ema.update(encrypted);
+        auto time_end = chrono::high_resolution_clock::now();
+        update_time += chrono::duration_cast<chrono::microseconds>(time_end - time_start);
+
+        ref_recent.push_back(batch);
+        if (ref_recent.size() > sliding_window)
+        {
+            ref_recent.pop_front();
+        }
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            ref_sum[i] += batch[i];
+            ref_tumbling[i] += batch[i];
+            ref_ema[i] = (1 - alpha) * ref_ema[i] + alpha * batch[i];
+        }
+        if ((t + 1) % tumbling_window == 0)
+        {
+            ref_closed = ref_tumbling;
+            fill(ref_tumbling.begin(), ref_tumbling.end(), 0.0);
+        }
+
+        if ((t + 1) % report_every == 0)
+        {
+            vector<double> ref_sliding_mean(slot_count, 0.0);
+            for (auto &recent : ref_recent)
+            {
+                for (size_t i = 0; i < slot_count; i++)
+                {
+                    ref_sliding_mean[i] += recent[i] / static_cast<double>(ref_recent.size());
+                }
+            }
+            vector<double> ref_mean(slot_count);
+            for (size_t i = 0; i < slot_count; i++)
+            {
+                ref_mean[i] = ref_sum[i] / static_cast<double>(t + 1);
+            }
+
+            print_line(__LINE__);
+            cout << "After " << (t + 1) << " events:" << endl;
+            cout << "    + Update time per event (all accumulators): " << update_time.count() / report_every
+                 << " microseconds" << endl;
+            cout << "    + Running mean error: " << max_abs_error(ref_mean, decrypt(running.mean())) << endl;
+            cout << "    + Sliding mean error: " << max_abs_error(ref_sliding_mean, decrypt(sliding.mean())) << endl;
+            if (have_closed)
+            {
+                cout << "    + Last tumbling window error: " << max_abs_error(ref_closed, decrypt(closed)) << endl;
+            }
+            cout << "    + EMA error: " << max_abs_error(ref_ema, decrypt(ema.value())) << ", level "
+                 << session->context().get_context_data(ema.value().parms_id())->chain_index() << ", log2(scale) "
+                 << log2(ema.value().scale()) << endl;
+            update_time = chrono::microseconds(0);
+        }
+    }
+    cout << "    + EMA:" << endl;
+    print_vector(decrypt(ema.value()), 3, 7);
+}
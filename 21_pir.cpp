@@ -0,0 +1,366 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+#include "seal/util/uintarithsmallmod.h"
+#include <cstdio>
+#include <functional>
+
+using namespace std;
+using namespace seal;
+
+/*
+BFV로 암호화된 인덱스를 사용한 데이터베이스 조회(PIR 형태)입니다. 데이터베이스의 각 행은 example_rotation_bfv()와
+같은 BatchEncoder 슬롯 배치로 평문 하나에 담기며, 서버는 어떤 행이 선택되었는지 알지 못한 채 선택된 행의 암호문을
+돌려줍니다.
+
+    answer = sum_r selector_r * row_r      (selector_r은 r이 요청된 행이면 1, 아니면 0을 암호화한 것)
+
+클라이언트는 두 가지 형태의 질의를 보낼 수 있습니다.
+    - one-hot: 행마다 selector 암호문 하나. 질의가 크지만 서버는 평문-암호문 곱셈만 합니다.
+    - 비트 분해: 인덱스의 비트마다 암호문 하나(ceil(log2(rows))개). 서버는 bit_j와 1 - bit_j를 곱해 selector를
+      만듭니다. 비트를 반으로 나누어 재귀적으로 곱하므로 곱셈 깊이는 ceil(log2(비트 수))입니다.
+
+평문-암호문 곱셈은 NTT 영역에서 계수별 곱셈이 되므로, 데이터베이스의 평문은 미리 NTT 형태로 변환하여 파일에 쓰고
+mmap합니다. 서버는 selector를 NTT 형태로 바꾼 뒤 mmap된 계수를 그대로 읽으며 곱셈과 덧셈을 한 번에 수행하고,
+마지막에 한 번만 NTT 역변환을 합니다. 행들은 여러 스레드에 나누어 처리하고 스레드별 부분합을 더합니다.
+*/
+#ifdef __linux__
+namespace
+{
+    /*
+    데이터베이스 파일 형식: [행 수][coeff_modulus 크기 L][N][행마다 L * N개의 NTT 계수]. 헤더가 8바이트 단위이므로
+    mmap된 계수는 uint64_t로 정렬되어 있습니다.
+    */
+    void write_database(
+        const string &path, const SEALContext &context, const BatchEncoder &batch_encoder, const Evaluator &evaluator,
+        const vector<vector<uint64_t>> &rows)
+    {
+        auto &parms = context.first_context_data()->parms();
+        ofstream stream(path, ios::binary | ios::trunc);
+        write_uint64(stream, rows.size());
+        write_uint64(stream, parms.coeff_modulus().size());
+        write_uint64(stream, parms.poly_modulus_degree());
+        Plaintext plain;
+        for (auto &row : rows)
+        {
+            batch_encoder.encode(row, plain);
+            evaluator.transform_to_ntt_inplace(plain, context.first_parms_id());
+            stream.write(
+                reinterpret_cast<const char *>(plain.data()),
+                static_cast<streamsize>(plain.coeff_count() * sizeof(uint64_t)));
+        }
+    }
+
+    class EncryptedDatabase
+    {
+    public:
+        EncryptedDatabase(SEALSession &session, const string &path) : session_(session), file_(path)
+        {
+            row_count_ = static_cast<size_t>(file_.read_uint64(0));
+            coeff_modulus_size_ = static_cast<size_t>(file_.read_uint64(sizeof(uint64_t)));
+            poly_modulus_degree_ = static_cast<size_t>(file_.read_uint64(2 * sizeof(uint64_t)));
+            auto &parms = session_.context().first_context_data()->parms();
+            if (coeff_modulus_size_ != parms.coeff_modulus().size() ||
+                poly_modulus_degree_ != parms.poly_modulus_degree() ||
+                file_.size() != 3 * sizeof(uint64_t) + row_count_ * row_size() * sizeof(uint64_t))
+            {
+                throw invalid_argument("database file does not match the encryption parameters");
+            }
+            coeffs_ = reinterpret_cast<const uint64_t *>(file_.data() + 3 * sizeof(uint64_t));
+        }
+
+        size_t row_count() const noexcept
+        {
+            return row_count_;
+        }
+
+        size_t index_bit_count() const noexcept
+        {
+            size_t bits = 0;
+            while ((size_t(1) << bits) < row_count_)
+            {
+                bits++;
+            }
+            return max<size_t>(1, bits);
+        }
+
+        /*
+        one-hot 질의에 대한 답: selector를 NTT 형태로 바꾸고 데이터베이스와의 내적을 계산합니다.
+        */
+        void answer(vector<Ciphertext> selectors, Ciphertext &destination, size_t thread_count) const
+        {
+            if (selectors.size() != row_count_)
+            {
+                throw invalid_argument("one selector per row is required");
+            }
+            auto &evaluator = session_.evaluator();
+            parallel_for(
+                selectors.size(), thread_count, [&](size_t r) { evaluator.transform_to_ntt_inplace(selectors[r]); });
+            inner_product(selectors, destination, thread_count);
+            evaluator.transform_from_ntt_inplace(destination);
+        }
+
+        /*
+        비트 분해 질의에 대한 답: 비트 암호문들로부터 selector를 만든 뒤 one-hot 질의와 같이 처리합니다.
+        */
+        void answer_bits(const vector<Ciphertext> &bits, Ciphertext &destination, size_t thread_count) const
+        {
+            if (bits.size() != index_bit_count())
+            {
+                throw invalid_argument("wrong number of index bits");
+            }
+            answer(expand(bits, 0, bits.size(), row_count_, thread_count), destination, thread_count);
+        }
+
+    private:
+        size_t row_size() const noexcept
+        {
+            return coeff_modulus_size_ * poly_modulus_degree_;
+        }
+
+        static void parallel_for(size_t count, size_t thread_count, const function<void(size_t)> &body)
+        {
+            atomic<size_t> next{ 0 };
+            vector<thread> threads;
+            for (size_t t = 0; t < min(thread_count, count); t++)
+            {
+                threads.emplace_back([&]() {
+                    for (size_t i = next++; i < count; i = next++)
+                    {
+                        body(i);
+                    }
+                });
+            }
+            for (auto &th : threads)
+            {
+                th.join();
+            }
+        }
+
+        /*
+        bits[begin, end)가 나타내는 값 v(리틀 엔디안)에 대해 selector_v를 처음 count개만 만듭니다. 아래쪽 절반과
+        위쪽 절반의 selector를 재귀적으로 만든 뒤 selector_v = low_(v mod 2^h) * high_(v / 2^h)입니다.
+        */
+        vector<Ciphertext> expand(
+            const vector<Ciphertext> &bits, size_t begin, size_t end, size_t count, size_t thread_count) const
+        {
+            auto &evaluator = session_.evaluator();
+            if (end - begin == 1)
+            {
+                Plaintext plain_one("1");
+                vector<Ciphertext> selectors(min<size_t>(count, 2));
+                evaluator.negate(bits[begin], selectors[0]);
+                evaluator.add_plain_inplace(selectors[0], plain_one);
+                if (count > 1)
+                {
+                    selectors[1] = bits[begin];
+                }
+                return selectors;
+            }
+
+            size_t mid = begin + (end - begin) / 2;
+            size_t low_size = size_t(1) << (mid - begin);
+            vector<Ciphertext> low = expand(bits, begin, mid, min(count, low_size), thread_count);
+            vector<Ciphertext> high = expand(bits, mid, end, (count + low_size - 1) / low_size, thread_count);
+
+            auto &relin_keys = session_.relin_keys();
+            vector<Ciphertext> selectors(count);
+            parallel_for(count, thread_count, [&](size_t v) {
+                evaluator.multiply(low[v % low_size], high[v / low_size], selectors[v]);
+                evaluator.relinearize_inplace(selectors[v], relin_keys);
+            });
+            return selectors;
+        }
+
+        /*
+        NTT 영역에서 sum_r selector_r * row_r을 계산합니다. 각 스레드는 연속된 행의 구간을 맡아 자신의 부분합에
+        곱셈-덧셈을 누적하고, 마지막에 부분합들을 더합니다. 데이터베이스 계수는 mmap된 파일에서 직접 읽습니다.
+        */
+        void inner_product(const vector<Ciphertext> &selectors, Ciphertext &destination, size_t thread_count) const
+        {
+            auto &coeff_modulus = session_.context().first_context_data()->parms().coeff_modulus();
+            size_t n = poly_modulus_degree_;
+            size_t poly_size = row_size();
+            thread_count = max<size_t>(1, min(thread_count, row_count_));
+
+            vector<vector<uint64_t>> partial_sums(thread_count, vector<uint64_t>(2 * poly_size, 0));
+            vector<thread> threads;
+            for (size_t t = 0; t < thread_count; t++)
+            {
+                threads.emplace_back([&, t]() {
+                    auto &sum = partial_sums[t];
+                    size_t begin = row_count_ * t / thread_count;
+                    size_t end = row_count_ * (t + 1) / thread_count;
+                    for (size_t r = begin; r < end; r++)
+                    {
+                        const uint64_t *row = coeffs_ + r * poly_size;
+                        for (size_t p = 0; p < 2; p++)
+                        {
+                            const uint64_t *selector = selectors[r].data(p);
+                            uint64_t *acc = sum.data() + p * poly_size;
+                            for (size_t j = 0; j < coeff_modulus_size_; j++)
+                            {
+                                const Modulus &modulus = coeff_modulus[j];
+                                size_t offset = j * n;
+                                for (size_t i = offset; i < offset + n; i++)
+                                {
+                                    acc[i] = util::add_uint_mod(
+                                        acc[i], util::multiply_uint_mod(selector[i], row[i], modulus), modulus);
+                                }
+                            }
+                        }
+                    }
+                });
+            }
+            for (auto &th : threads)
+            {
+                th.join();
+            }
+
+            destination = selectors[0];
+            for (size_t p = 0; p < 2; p++)
+            {
+                uint64_t *result = destination.data(p);
+                for (size_t j = 0; j < coeff_modulus_size_; j++)
+                {
+                    const Modulus &modulus = coeff_modulus[j];
+                    for (size_t i = j * n; i < (j + 1) * n; i++)
+                    {
+                        uint64_t value = 0;
+                        for (auto &sum : partial_sums)
+                        {
+                            value = util::add_uint_mod(value, sum[p * poly_size + i], modulus);
+                        }
+                        result[i] = value;
+                    }
+                }
+            }
+        }
+
+        SEALSession &session_;
+
+        MappedFile file_;
+
+        const uint64_t *coeffs_ = nullptr;
+
+        size_t row_count_ = 0;
+
+        size_t coeff_modulus_size_ = 0;
+
+        size_t poly_modulus_degree_ = 0;
+    };
+
+    streamoff query_size(const vector<Ciphertext> &query)
+    {
+        streamoff bytes = 0;
+        for (auto &encrypted : query)
+        {
+            bytes += encrypted.save_size(compr_mode_type::none);
+        }
+        return bytes;
+    }
+} // namespace
+#endif
+
+void example_pir()
+{
+    print_example_banner("Example: Encrypted Database Lookup (PIR)");
+
+#ifndef __linux__
+    cout << "This example memory-maps the database with mmap (Linux)." << endl;
+#else
+    /*
+    example_rotation_bfv()와 같은 매개변수이지만 평문 모듈러스를 17비트로 줄였습니다. 비트 분해 질의의 곱셈마다
+    대략 log2(plain_modulus) + log2(N) 비트의 noise budget이 소모되므로, 256행(곱셈 깊이 3)까지 여유가 남습니다.
+    */
+    EncryptionParameters parms(scheme_type::bfv);
+    size_t poly_modulus_degree = 8192;
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    parms.set_coeff_modulus(CoeffModulus::BFVDefault(poly_modulus_degree));
+    parms.set_plain_modulus(PlainModulus::Batching(poly_modulus_degree, 17));
+
+    auto session = SEALSession::Get(parms);
+    const SEALContext &context = session->context();
+    print_parameters(context);
+    cout << endl;
+
+    auto &batch_encoder = session->batch_encoder();
+    auto &evaluator = session->evaluator();
+    auto &encryptor = session->encryptor();
+    auto &decryptor = session->decryptor();
+    session->relin_keys();
+    size_t slot_count = batch_encoder.slot_count();
+    uint64_t plain_modulus = parms.plain_modulus().value();
+    size_t thread_count = max<size_t>(1, thread::hardware_concurrency());
+
+    string path = "pir_database.bin";
+    mt19937_64 engine(7);
+
+    for (size_t row_count : { 16, 64, 256 })
+    {
+        /*
+        무작위 데이터베이스를 만들어 NTT 형태로 파일에 쓰고 mmap합니다.
+        */
+        vector<vector<uint64_t>> rows(row_count, vector<uint64_t>(slot_count));
+        for (auto &row : rows)
+        {
+            for (auto &value : row)
+            {
+                value = engine() % plain_modulus;
+            }
+        }
+        write_database(path, context, batch_encoder, evaluator, rows);
+        EncryptedDatabase database(*session, path);
+        size_t target = static_cast<size_t>(engine() % row_count);
+
+        print_line(__LINE__);
+        cout << "Database of " << row_count << " rows x " << slot_count << " slots, query row " << target << "."
+             << endl;
+
+        auto check = [&](Ciphertext &answer) {
+            Plaintext plain;
+            decryptor.decrypt(answer, plain);
+            vector<uint64_t> decoded;
+            batch_encoder.decode(plain, decoded);
+            cout << "        Noise budget left: " << decryptor.invariant_noise_budget(answer) << " bits, row matches: "
+                 << (decoded == rows[target] ? "yes" : "no") << endl;
+        };
+
+        /*
+        one-hot 질의: 행마다 0 또는 1을 암호화합니다. BFV에서 상수 다항식은 모든 슬롯에 같은 값을 담습니다.
+        */
+        vector<Ciphertext> one_hot(row_count);
+        for (size_t r = 0; r < row_count; r++)
+        {
+            encryptor.encrypt(Plaintext(r == target ? "1" : "0"), one_hot[r]);
+        }
+        streamoff one_hot_bytes = query_size(one_hot);
+        Ciphertext answer;
+        auto time_start = chrono::high_resolution_clock::now();
+        database.answer(move(one_hot), answer, thread_count);
+        auto time_end = chrono::high_resolution_clock::now();
+        double seconds = chrono::duration<double>(time_end - time_start).count();
+        cout << "    + One-hot query (" << (one_hot_bytes >> 10) << " KB): " << 1.0 / seconds << " queries/s" << endl;
+        check(answer);
+
+        /*
+        비트 분해 질의: 인덱스의 비트마다 하나의 암호문을 보냅니다.
+        */
+        vector<Ciphertext> bits(database.index_bit_count());
+        for (size_t j = 0; j < bits.size(); j++)
+        {
+            encryptor.encrypt(Plaintext(((target >> j) & 1) ? "1" : "0"), bits[j]);
+        }
+        time_start = chrono::high_resolution_clock::now();
+        database.answer_bits(bits, answer, thread_count);
+        time_end = chrono::high_resolution_clock::now();
+        seconds = chrono::duration<double>(time_end - time_start).count();
+        cout << "    + Bit-decomposed query (" << (query_size(bits) >> 10) << " KB): " << 1.0 / seconds
+             << " queries/s" << endl;
+        check(answer);
+    }
+
+    std::remove(path.c_str());
+#endif
+}
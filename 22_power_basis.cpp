@@ -0,0 +1,324 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+
+using namespace std;
+using namespace seal;
+
+/*
+같은 암호화된 입력 x에 대해 여러 다항식을 평가할 때, 다항식마다 x^2, x^3, x^4를 새로 계산하면 같은 곱셈과
+재선형화를 반복하게 됩니다. PowerBasis는 x의 거듭제곱을 한 번만 계산하여 보관하고, 임의의 다항식을 그 위에서
+평가합니다.
+
+    - x^k는 필요할 때 한 번만 계산됩니다. k가 2의 거듭제곱이면 x^(k/2)의 제곱, 아니면 k 이하의 가장 큰 2의
+      거듭제곱 p에 대해 x^p * x^(k - p)입니다. 따라서 x^k는 ceil(log2(k))번 rescale된 레벨에 놓이며, 이는 가능한
+      가장 높은 레벨입니다.
+    - 레벨이 다른 두 거듭제곱을 곱할 때는 높은 레벨의 것을 mod switch한 사본을 사용하므로 보관된 거듭제곱은 모두
+      자신의 가장 높은 레벨에 남습니다.
+    - 다항식의 각 항 c_k * x^k는 x^k에 계수를 나중에 곱하지 않고, 5_ckks_basics.cpp의 PI*x처럼 계수를 먼저 x에 곱한
+      뒤 보관된 x^(2^j)들을 곱해 올라갑니다. 그러면 항은 ceil(log2(k + 1))번 rescale된 레벨에 놓입니다. x^k에 계수를
+      곱하면 한 레벨을 더 쓰게 됩니다(polynomial_depth(degree)는 이 경우의 상한입니다). 항들은 가장 낮은 레벨로
+      맞추어 더합니다.
+    - 따라서 공유되는 것은 x^(2^j)들이며, 항마다 계수가 곱해진 사슬에 대한 곱셈은 따로 필요합니다.
+    - 스케일은 9_my_ckks.cpp와 같이 rescale 후 scale로 다시 맞춥니다.
+*/
+namespace
+{
+    class PowerBasis
+    {
+    public:
+        PowerBasis(SEALSession &session, const Ciphertext &x, double scale) : session_(session), scale_(scale)
+        {
+            powers_.emplace(1, x);
+        }
+
+        /*
+        x^k를 돌려줍니다. 아직 없으면 필요한 낮은 거듭제곱과 함께 계산하여 보관합니다.
+        */
+        const Ciphertext &power(size_t k)
+        {
+            if (k == 0)
+            {
+                throw invalid_argument("power must be positive");
+            }
+            auto it = powers_.find(k);
+            if (it != powers_.end())
+            {
+                return it->second;
+            }
+
+            size_t high = 1;
+            while (high * 2 <= k)
+            {
+                high *= 2;
+            }
+            size_t a = high == k ? k / 2 : high;
+            size_t b = k - a;
+            const Ciphertext &x_a = power(a);
+            const Ciphertext &x_b = power(b);
+
+            auto &evaluator = session_.evaluator();
+            Ciphertext result;
+            if (a == b)
+            {
+                evaluator.square(x_a, result);
+            }
+            else if (x_b.parms_id() != x_a.parms_id())
+            {
+                Ciphertext x_b_switched;
+                evaluator.mod_switch_to(x_b, x_a.parms_id(), x_b_switched);
+                evaluator.multiply(x_a, x_b_switched, result);
+            }
+            else
+            {
+                evaluator.multiply(x_a, x_b, result);
+            }
+            evaluator.relinearize_inplace(result, session_.relin_keys());
+            evaluator.rescale_to_next_inplace(result);
+            result.scale() = scale_;
+            multiplication_count_++;
+
+            return powers_.emplace(k, move(result)).first->second;
+        }
+
+        /*
+        coeffs[k]를 x^k의 계수로 하는 다항식을 평가합니다. 계수가 0인 항은 건너뜁니다.
+        */
+        void evaluate(const vector<double> &coeffs, Ciphertext &destination)
+        {
+            auto &context = session_.context();
+            auto &evaluator = session_.evaluator();
+            auto &encoder = session_.ckks_encoder();
+
+            vector<Ciphertext> terms;
+            Plaintext plain_coeff;
+            for (size_t k = 1; k < coeffs.size(); k++)
+            {
+                if (coeffs[k] == 0.0)
+                {
+                    continue;
+                }
+                Ciphertext term;
+                scaled_power(coeffs[k], k, term);
+                terms.push_back(move(term));
+            }
+            if (terms.empty())
+            {
+                throw invalid_argument("polynomial must have a non-constant term");
+            }
+
+            parms_id_type lowest_parms_id = terms[0].parms_id();
+            for (auto &term : terms)
+            {
+                if (context.get_context_data(term.parms_id())->chain_index() <
+                    context.get_context_data(lowest_parms_id)->chain_index())
+                {
+                    lowest_parms_id = term.parms_id();
+                }
+            }
+            for (auto &term : terms)
+            {
+                if (term.parms_id() != lowest_parms_id)
+                {
+                    evaluator.mod_switch_to_inplace(term, lowest_parms_id);
+                }
+            }
+            evaluator.add_many(terms, destination);
+
+            if (coeffs[0] != 0.0)
+            {
+                encoder.encode(coeffs[0], lowest_parms_id, scale_, plain_coeff);
+                evaluator.add_plain_inplace(destination, plain_coeff);
+            }
+        }
+
+        /*
+        coeff * x^k를 계산합니다. k = a + b(a는 power()와 같은 분할)로 나누어 coeff * x^b를 재귀적으로 만든 뒤 x^a를
+        곱합니다. coeff * x의 깊이가 1이므로 결과의 깊이는 ceil(log2(k + 1))입니다.
+        */
+        void scaled_power(double coeff, size_t k, Ciphertext &destination)
+        {
+            auto &evaluator = session_.evaluator();
+            if (k == 1)
+            {
+                const Ciphertext &x = power(1);
+                Plaintext plain_coeff;
+                session_.ckks_encoder().encode(coeff, x.parms_id(), scale_, plain_coeff);
+                evaluator.multiply_plain(x, plain_coeff, destination);
+                evaluator.rescale_to_next_inplace(destination);
+                destination.scale() = scale_;
+                return;
+            }
+
+            size_t high = 1;
+            while (high * 2 <= k)
+            {
+                high *= 2;
+            }
+            size_t a = high == k ? k / 2 : high;
+            scaled_power(coeff, k - a, destination);
+            const Ciphertext &x_a = power(a);
+
+            auto &context = session_.context();
+            size_t level = context.get_context_data(destination.parms_id())->chain_index();
+            size_t level_a = context.get_context_data(x_a.parms_id())->chain_index();
+            if (level > level_a)
+            {
+                evaluator.mod_switch_to_inplace(destination, x_a.parms_id());
+            }
+            if (level_a > level)
+            {
+                Ciphertext x_a_switched;
+                evaluator.mod_switch_to(x_a, destination.parms_id(), x_a_switched);
+                evaluator.multiply_inplace(destination, x_a_switched);
+            }
+            else
+            {
+                evaluator.multiply_inplace(destination, x_a);
+            }
+            evaluator.relinearize_inplace(destination, session_.relin_keys());
+            evaluator.rescale_to_next_inplace(destination);
+            destination.scale() = scale_;
+            multiplication_count_++;
+        }
+
+        /*
+        지금까지 수행한 암호문-암호문 곱셈(각각 재선형화와 rescale 한 번씩)의 횟수입니다.
+        */
+        size_t multiplication_count() const noexcept
+        {
+            return multiplication_count_;
+        }
+
+    private:
+        SEALSession &session_;
+
+        double scale_;
+
+        map<size_t, Ciphertext> powers_;
+
+        size_t multiplication_count_ = 0;
+    };
+
+    struct NamedPolynomial
+    {
+        string name;
+        vector<double> coeffs;
+    };
+
+    double evaluate_plain(const vector<double> &coeffs, double x)
+    {
+        double result = 0;
+        for (size_t k = coeffs.size(); k-- > 0;)
+        {
+            result = result * x + coeffs[k];
+        }
+        return result;
+    }
+} // namespace
+
+void example_power_basis()
+{
+    print_example_banner("Example: Shared Power Basis");
+
+    EncryptionParameters parms(scheme_type::ckks);
+    size_t poly_modulus_degree = 16384;
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, 50, 50, 50, 50, 60 }));
+    double scale = pow(2.0, 50);
+
+    auto session = SEALSession::Get(parms);
+    const SEALContext &context = session->context();
+    print_parameters(context);
+    cout << endl;
+
+    auto &encoder = session->ckks_encoder();
+    auto &encryptor = session->encryptor();
+    auto &decryptor = session->decryptor();
+    session->relin_keys();
+    size_t slot_count = encoder.slot_count();
+
+    vector<double> input(slot_count);
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        input[i] = static_cast<double>(i) / static_cast<double>(slot_count - 1);
+    }
+    Plaintext x_plain;
+    encoder.encode(input, scale, x_plain);
+    Ciphertext x1_encrypted;
+    encryptor.encrypt(x_plain, x1_encrypted);
+
+    /*
+    5_ckks_basics.cpp와 9_my_ckks.cpp의 다항식, 그리고 17_inference.cpp의 sigmoid 근사와 제곱 특성입니다.
+    */
+    vector<NamedPolynomial> polynomials = { { "PI*x^3 + 0.4x + 1", { 1.0, 0.4, 0.0, 3.14159265 } },
+                                            { "(x + 1)^2 * (x^2 + 2)", { 2.0, 4.0, 3.0, 2.0, 1.0 } },
+                                            { "0.5 + 0.197x - 0.004x^3", { 0.5, 0.197, 0.0, -0.004 } },
+                                            { "x^2", { 0.0, 0.0, 1.0 } } };
+
+    chrono::high_resolution_clock::time_point time_start, time_end;
+
+    /*
+    기준: 다항식마다 자신의 거듭제곱을 새로 계산합니다.
+    */
+    print_line(__LINE__);
+    cout << "Evaluate each polynomial with its own powers of x." << endl;
+    size_t separate_multiplications = 0;
+    time_start = chrono::high_resolution_clock::now();
+    for (auto &polynomial : polynomials)
+    {
+        PowerBasis basis(*session, x1_encrypted, scale);
+        Ciphertext result;
+        basis.evaluate(polynomial.coeffs, result);
+        separate_multiplications += basis.multiplication_count();
+    }
+    time_end = chrono::high_resolution_clock::now();
+    auto separate_time = chrono::duration_cast<chrono::microseconds>(time_end - time_start);
+    cout << "    + " << separate_multiplications << " ciphertext multiplications, " << separate_time.count()
+         << " microseconds" << endl;
+
+    /*
+    공유: 하나의 PowerBasis 위에서 모든 다항식을 평가합니다.
+    */
+    print_line(__LINE__);
+    cout << "Evaluate all polynomials on one shared power basis." << endl;
+    PowerBasis basis(*session, x1_encrypted, scale);
+    vector<Ciphertext> results(polynomials.size());
+    time_start = chrono::high_resolution_clock::now();
+    for (size_t p = 0; p < polynomials.size(); p++)
+    {
+        basis.evaluate(polynomials[p].coeffs, results[p]);
+    }
+    time_end = chrono::high_resolution_clock::now();
+    auto shared_time = chrono::duration_cast<chrono::microseconds>(time_end - time_start);
+    cout << "    + " << basis.multiplication_count() << " ciphertext multiplications, " << shared_time.count()
+         << " microseconds" << endl;
+    cout << "    + Multiplications and relinearizations saved: "
+         << separate_multiplications - basis.multiplication_count() << endl;
+
+    print_line(__LINE__);
+    cout << "Check the results." << endl;
+    Plaintext plain_result;
+    vector<double> decoded;
+    for (size_t p = 0; p < polynomials.size(); p++)
+    {
+        auto &polynomial = polynomials[p];
+        decryptor.decrypt(results[p], plain_result);
+        encoder.decode(plain_result, decoded);
+        vector<double> expected(slot_count);
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            expected[i] = evaluate_plain(polynomial.coeffs, input[i]);
+        }
+        size_t levels_used = context.first_context_data()->chain_index() -
+                             context.get_context_data(results[p].parms_id())->chain_index();
+        cout << "    + " << polynomial.name << ": levels used " << levels_used << " (upper bound "
+             << polynomial_depth(polynomial.coeffs.size() - 1) << "), max error " << max_abs_error(expected, decoded)
+             << endl;
+    }
+    decryptor.decrypt(results[1], plain_result);
+    encoder.decode(plain_result, decoded);
+    cout << "    + Computed result of " << polynomials[1].name << ":" << endl;
+    print_vector(decoded, 3, 7);
+}
@@ -0,0 +1,265 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+#include <functional>
+
+using namespace std;
+using namespace seal;
+
+/*
+KeyGenerator::create_galois_keys()는 모든 Galois 원소에 대한 키를 하나의 스레드에서 차례로 만듭니다. 그런데 각
+Galois 원소의 키는 서로 독립적이므로 여러 코어에서 나누어 만들 수 있습니다.
+
+ParallelKeyGenerator는 다음과 같이 동작합니다.
+    - 작업 목록은 재선형화 키 하나와 Galois 원소마다 하나씩의 Galois 키입니다. 재선형화 키는 공개 API로는
+      구성 요소별로 나눌 수 없으므로 하나의 작업으로 다른 Galois 키들과 동시에 만들어집니다.
+    - 각 워커 스레드는 같은 비밀 키로 자신의 KeyGenerator를 만들고, 작업 목록에서 다음 작업을 가져와 처리합니다.
+    - Galois 키는 원소 하나짜리 GaloisKeys로 만들어진 뒤 GaloisKeys::get_index(elt) 위치로 옮겨져 하나로 합쳐집니다.
+    - 작업을 가져오기 전마다 취소 플래그를 확인하며, 작업이 끝날 때마다 진행 콜백을 호출하고 소요 시간을 기록합니다.
+*/
+namespace
+{
+    struct KeyTiming
+    {
+        string name;
+        double milliseconds;
+    };
+
+    class ParallelKeyGenerator
+    {
+    public:
+        using ProgressCallback = function<void(size_t done, size_t total)>;
+
+        ParallelKeyGenerator(const SEALContext &context, const SecretKey &secret_key)
+            : context_(context), secret_key_(secret_key)
+        {
+        }
+
+        /*
+        재선형화 키와 전체 Galois 키 집합을 만듭니다. cancel이 설정되면 남은 작업을 시작하지 않고 false를 돌려주며,
+        이때 destination들과 timings()는 변경되지 않습니다. 워커 하나가 예외를 던지면 나머지 워커도 남은 작업을
+        시작하지 않으며, 그 예외가 다시 던져집니다.
+        */
+        bool generate(
+            RelinKeys &relin_keys, GaloisKeys &galois_keys, size_t thread_count, const atomic<bool> &cancel,
+            const ProgressCallback &progress = nullptr)
+        {
+            vector<uint32_t> galois_elts = context_.key_context_data()->galois_tool()->get_elts_all();
+            size_t task_count = galois_elts.size() + 1;
+            thread_count = max<size_t>(1, min(thread_count, task_count));
+
+            RelinKeys new_relin_keys;
+            vector<GaloisKeys> partial_keys(galois_elts.size());
+            vector<KeyTiming> timings(task_count);
+
+            atomic<size_t> next_task{ 0 };
+            atomic<size_t> done_count{ 0 };
+            atomic<bool> failed{ false };
+            mutex progress_mutex;
+            exception_ptr error;
+            vector<thread> threads;
+            for (size_t t = 0; t < thread_count; t++)
+            {
+                threads.emplace_back([&]() {
+                    try
+                    {
+                        KeyGenerator keygen(context_, secret_key_);
+                        for (size_t task = next_task++; task < task_count && !cancel.load() && !failed.load();
+                             task = next_task++)
+                        {
+                            auto time_start = chrono::high_resolution_clock::now();
+                            if (task == 0)
+                            {
+                                keygen.create_relin_keys(new_relin_keys);
+                                timings[task].name = "relin";
+                            }
+                            else
+                            {
+                                uint32_t elt = galois_elts[task - 1];
+                                keygen.create_galois_keys(vector<uint32_t>{ elt }, partial_keys[task - 1]);
+                                timings[task].name = "galois " + to_string(elt);
+                            }
+                            auto time_end = chrono::high_resolution_clock::now();
+                            timings[task].milliseconds =
+                                chrono::duration<double, milli>(time_end - time_start).count();
+
+                            size_t done = ++done_count;
+                            if (progress)
+                            {
+                                lock_guard<mutex> lock(progress_mutex);
+                                progress(done, task_count);
+                            }
+                        }
+                    }
+                    catch (...)
+                    {
+                        failed = true;
+                        lock_guard<mutex> lock(progress_mutex);
+                        error = current_exception();
+                    }
+                });
+            }
+            for (auto &th : threads)
+            {
+                th.join();
+            }
+            if (error)
+            {
+                rethrow_exception(error);
+            }
+            if (done_count != task_count)
+            {
+                return false;
+            }
+
+            /*
+            원소별 키를 하나의 GaloisKeys로 합칩니다. create_galois_keys는 data()를 Galois 원소의 색인 범위 전체로
+            늘리고 해당 원소의 위치만 채웁니다.
+            */
+            GaloisKeys merged;
+            merged.parms_id() = partial_keys[0].parms_id();
+            merged.data().resize(partial_keys[0].data().size());
+            for (size_t i = 0; i < galois_elts.size(); i++)
+            {
+                size_t index = GaloisKeys::get_index(galois_elts[i]);
+                merged.data()[index] = move(partial_keys[i].data()[index]);
+            }
+
+            relin_keys = move(new_relin_keys);
+            galois_keys = move(merged);
+            timings_ = move(timings);
+            return true;
+        }
+
+        /*
+        마지막으로 성공한 generate()의 작업별 소요 시간입니다.
+        */
+        const vector<KeyTiming> &timings() const noexcept
+        {
+            return timings_;
+        }
+
+    private:
+        const SEALContext &context_;
+
+        SecretKey secret_key_;
+
+        vector<KeyTiming> timings_;
+    };
+} // namespace
+
+void example_keygen()
+{
+    print_example_banner("Example: Parallel Key Generation");
+
+    EncryptionParameters parms(scheme_type::ckks);
+    size_t poly_modulus_degree = 16384;
+    parms.set_poly_modulus_degree(poly_modulus_degree);
+    parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, 50, 50, 50, 50, 60 }));
+    double scale = pow(2.0, 50);
+
+    auto session = SEALSession::Get(parms);
+    const SEALContext &context = session->context();
+    print_parameters(context);
+    cout << endl;
+
+    const SecretKey &secret_key = session->secret_key();
+    chrono::high_resolution_clock::time_point time_start, time_end;
+
+    /*
+    기준: 예제들처럼 하나의 KeyGenerator로 차례로 만듭니다.
+    */
+    print_line(__LINE__);
+    cout << "Generate relinearization keys and all Galois keys on one thread." << endl;
+    time_start = chrono::high_resolution_clock::now();
+    {
+        KeyGenerator keygen(context, secret_key);
+        RelinKeys relin_keys;
+        keygen.create_relin_keys(relin_keys);
+        GaloisKeys galois_keys;
+        keygen.create_galois_keys(galois_keys);
+    }
+    time_end = chrono::high_resolution_clock::now();
+    auto baseline_time = chrono::duration_cast<chrono::milliseconds>(time_end - time_start);
+    cout << "    + " << baseline_time.count() << " milliseconds" << endl;
+
+    ParallelKeyGenerator parallel_keygen(context, secret_key);
+    atomic<bool> cancel{ false };
+    RelinKeys relin_keys;
+    GaloisKeys galois_keys;
+
+    size_t core_count = max<size_t>(1, thread::hardware_concurrency());
+    for (size_t thread_count = 1; thread_count <= core_count; thread_count *= 2)
+    {
+        print_line(__LINE__);
+        cout << "Generate the same keys on " << thread_count << " thread(s)." << endl;
+        time_start = chrono::high_resolution_clock::now();
+        parallel_keygen.generate(relin_keys, galois_keys, thread_count, cancel);
+        time_end = chrono::high_resolution_clock::now();
+        auto time_diff = chrono::duration_cast<chrono::milliseconds>(time_end - time_start);
+        cout << "    + " << time_diff.count() << " milliseconds, speedup "
+             << static_cast<double>(baseline_time.count()) / static_cast<double>(max<long long>(1, time_diff.count()))
+             << "x" << endl;
+    }
+
+    print_line(__LINE__);
+    cout << "Per-key timing of the last run:" << endl;
+    for (auto &timing : parallel_keygen.timings())
+    {
+        cout << "    + " << setw(12) << left << timing.name << right << timing.milliseconds << " ms" << endl;
+    }
+
+    /*
+    합쳐진 키가 올바른지 확인합니다.
+    */
+    print_line(__LINE__);
+    cout << "Square and rotate by 3 with the merged keys." << endl;
+    auto &encoder = session->ckks_encoder();
+    auto &evaluator = session->evaluator();
+    size_t slot_count = encoder.slot_count();
+    vector<double> input(slot_count);
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        input[i] = static_cast<double>(i % 16) / 16.0;
+    }
+    Plaintext plain;
+    encoder.encode(input, scale, plain);
+    Ciphertext encrypted;
+    session->encryptor().encrypt(plain, encrypted);
+    evaluator.square_inplace(encrypted);
+    evaluator.relinearize_inplace(encrypted, relin_keys);
+    evaluator.rescale_to_next_inplace(encrypted);
+    evaluator.rotate_vector_inplace(encrypted, 3, galois_keys);
+    session->decryptor().decrypt(encrypted, plain);
+    vector<double> result;
+    encoder.decode(plain, result);
+    double error = 0;
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        double v = input[(i + 3) % slot_count];
+        error = max(error, fabs(result[i] - v * v));
+    }
+    cout << "    + Max error: " << error << endl;
+
+    /*
+    진행 콜백에서 작업의 1/4이 끝나면 취소합니다. 이미 시작된 작업만 마치고 돌아옵니다.
+    */
+    print_line(__LINE__);
+    cout << "Cancel a run after a quarter of the keys." << endl;
+    RelinKeys cancelled_relin_keys;
+    GaloisKeys cancelled_galois_keys;
+    time_start = chrono::high_resolution_clock::now();
+    bool completed = parallel_keygen.generate(
+        cancelled_relin_keys, cancelled_galois_keys, core_count, cancel, [&cancel](size_t done, size_t total) {
+            cout << "\r    + Progress: " << done << "/" << total << flush;
+            if (done * 4 >= total)
+            {
+                cancel = true;
+            }
+        });
+    time_end = chrono::high_resolution_clock::now();
+    cout << endl;
+    cout << "    + Completed: " << (completed ? "yes" : "no") << ", returned after "
+         << chrono::duration_cast<chrono::milliseconds>(time_end - time_start).count() << " milliseconds" << endl;
+}
@@ -0,0 +1,308 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+#include <functional>
+
+using namespace std;
+using namespace seal;
+
+/*
+5_ckks_basics.cpp와 9_my_ckks.cpp는 rescale 후에 scale()을 2^40 또는 2^50으로 덮어씁니다. 실제로 나눈 소수 q는
+2^40이나 2^50과 조금 다르므로, 덮어쓸 때마다 값 전체에 q / 2^bits만큼의 상대 오차가 곱해집니다. 소수가 작을수록
+(2^bits에 가까운 NTT 친화적인 소수가 드물수록) 이 오차가 커집니다.
+
+ScaleManagedEvaluator의 exact 모드는 coeff_modulus의 실제 소수로부터 레벨(chain_index)마다 목표 스케일 S_i를
+정합니다.
+
+    S_top = q_top                 (맨 위 레벨에서 처음 버려지는 소수)
+    S_(i-1) = S_i * S_i / q_i     (레벨 i의 두 암호문을 곱하고 q_i로 rescale한 결과의 스케일)
+
+    - 같은 레벨의 두 암호문을 곱하면 rescale 결과가 정확히 S_(i-1)이 됩니다. SEAL과 같은 순서로 double 연산을
+      하므로 비트 단위까지 같습니다.
+    - 상수 c를 곱해 레벨 j로 내릴 때는 레벨 j + 1까지 mod switch한 뒤 c를 S_j * q_(j+1) / S 스케일로 인코딩합니다.
+      rescale 결과의 스케일은 S_j이며, 남는 것은 double 반올림 오차(상대 1e-16 정도)뿐입니다.
+    - 상수를 더할 때는 암호문의 스케일 그대로 인코딩합니다.
+    - 레벨이 다른 두 암호문을 더할 때는 높은 쪽에 1을 같은 방식으로 곱하여 내립니다. mod switch만 하면 스케일이
+      S_i로 남아 S_j와 맞지 않기 때문입니다.
+
+approximate 모드는 같은 회로를 기존 예제들처럼 목표 스케일 2^bits로 덮어쓰며 평가합니다.
+*/
+namespace
+{
+    enum class ScaleMode
+    {
+        approximate,
+        exact
+    };
+
+    class ScaleManagedEvaluator
+    {
+    public:
+        ScaleManagedEvaluator(SEALSession &session, ScaleMode mode, double nominal_scale)
+            : session_(session), mode_(mode), nominal_scale_(nominal_scale)
+        {
+            auto context_data = session_.context().first_context_data();
+            scales_.assign(context_data->chain_index() + 1, nominal_scale_);
+            if (mode_ == ScaleMode::exact)
+            {
+                scales_.back() = static_cast<double>(context_data->parms().coeff_modulus().back().value());
+                for (; context_data->next_context_data(); context_data = context_data->next_context_data())
+                {
+                    size_t i = context_data->chain_index();
+                    double q = static_cast<double>(context_data->parms().coeff_modulus().back().value());
+                    scales_[i - 1] = scales_[i] * scales_[i] / q;
+                }
+            }
+        }
+
+        /*
+        레벨(chain_index)의 목표 스케일입니다.
+        */
+        double target_scale(size_t level) const
+        {
+            return scales_.at(level);
+        }
+
+        void encrypt(const vector<double> &values, Ciphertext &destination) const
+        {
+            Plaintext plain;
+            session_.ckks_encoder().encode(values, scales_.back(), plain);
+            session_.encryptor().encrypt(plain, destination);
+        }
+
+        /*
+        a = a * b. 레벨이 다르면 높은 쪽의 사본을 낮은 쪽 레벨로 내린 뒤 곱합니다.
+        */
+        void multiply_inplace(Ciphertext &a, const Ciphertext &b) const
+        {
+            auto &evaluator = session_.evaluator();
+            if (level(a) > level(b))
+            {
+                lower_to(a, level(b));
+            }
+            if (level(b) > level(a))
+            {
+                Ciphertext b_lowered = b;
+                lower_to(b_lowered, level(a));
+                evaluator.multiply_inplace(a, b_lowered);
+            }
+            else
+            {
+                evaluator.multiply_inplace(a, b);
+            }
+            evaluator.relinearize_inplace(a, session_.relin_keys());
+            evaluator.rescale_to_next_inplace(a);
+            settle(a);
+        }
+
+        /*
+        encrypted = c * encrypted. 결과는 target_level에 놓이며 target_level은 현재 레벨보다 낮아야 합니다.
+        */
+        void multiply_const_inplace(Ciphertext &encrypted, double c, size_t target_level) const
+        {
+            auto &context = session_.context();
+            auto &evaluator = session_.evaluator();
+            if (target_level >= level(encrypted))
+            {
+                throw invalid_argument("target_level must be below the current level");
+            }
+            while (level(encrypted) > target_level + 1)
+            {
+                evaluator.mod_switch_to_next_inplace(encrypted);
+            }
+            double plain_scale = nominal_scale_;
+            if (mode_ == ScaleMode::exact)
+            {
+                double q = static_cast<double>(
+                    context.get_context_data(encrypted.parms_id())->parms().coeff_modulus().back().value());
+                plain_scale = scales_[target_level] * q / encrypted.scale();
+            }
+            Plaintext plain;
+            session_.ckks_encoder().encode(c, encrypted.parms_id(), plain_scale, plain);
+            evaluator.multiply_plain_inplace(encrypted, plain);
+            evaluator.rescale_to_next_inplace(encrypted);
+            settle(encrypted);
+        }
+
+        /*
+        a = a + b. 레벨이 다르면 높은 쪽을 낮은 쪽 레벨로 내립니다.
+        */
+        void add_inplace(Ciphertext &a, const Ciphertext &b) const
+        {
+            if (level(a) > level(b))
+            {
+                lower_to(a, level(b));
+            }
+            if (level(b) > level(a))
+            {
+                Ciphertext b_lowered = b;
+                lower_to(b_lowered, level(a));
+                session_.evaluator().add_inplace(a, b_lowered);
+            }
+            else
+            {
+                session_.evaluator().add_inplace(a, b);
+            }
+        }
+
+        void add_const_inplace(Ciphertext &encrypted, double c) const
+        {
+            Plaintext plain;
+            session_.ckks_encoder().encode(c, encrypted.parms_id(), encrypted.scale(), plain);
+            session_.evaluator().add_plain_inplace(encrypted, plain);
+        }
+
+        size_t level(const Ciphertext &encrypted) const
+        {
+            return session_.context().get_context_data(encrypted.parms_id())->chain_index();
+        }
+
+    private:
+        /*
+        approximate 모드에서는 기존 예제들처럼 스케일을 목표값으로 덮어씁니다. exact 모드에서는 스케일이 이미 목표값과
+        double 반올림 범위 안에서 같아야 하며, 그 반올림만 흡수합니다.
+        */
+        void settle(Ciphertext &encrypted) const
+        {
+            double target = scales_[level(encrypted)];
+            if (mode_ == ScaleMode::exact && fabs(encrypted.scale() / target - 1.0) > 1e-12)
+            {
+                throw logic_error("scale drifted from the schedule");
+            }
+            encrypted.scale() = target;
+        }
+
+        void lower_to(Ciphertext &encrypted, size_t target_level) const
+        {
+            if (mode_ == ScaleMode::exact)
+            {
+                multiply_const_inplace(encrypted, 1.0, target_level);
+            }
+            else
+            {
+                while (level(encrypted) > target_level)
+                {
+                    session_.evaluator().mod_switch_to_next_inplace(encrypted);
+                }
+            }
+        }
+
+        SEALSession &session_;
+
+        ScaleMode mode_;
+
+        double nominal_scale_;
+
+        vector<double> scales_;
+    };
+
+    /*
+    5_ckks_basics.cpp의 PI*x^3 + 0.4x + 1입니다.
+    */
+    void evaluate_cubic(const ScaleManagedEvaluator &evaluator, const Ciphertext &x, Ciphertext &destination)
+    {
+        size_t top = evaluator.level(x);
+        Ciphertext x2 = x;
+        evaluator.multiply_inplace(x2, x);
+        Ciphertext pi_x = x;
+        evaluator.multiply_const_inplace(pi_x, 3.14159265, top - 1);
+        evaluator.multiply_inplace(x2, pi_x);
+
+        Ciphertext x_coeff1 = x;
+        evaluator.multiply_const_inplace(x_coeff1, 0.4, evaluator.level(x2));
+        evaluator.add_inplace(x2, x_coeff1);
+        evaluator.add_const_inplace(x2, 1.0);
+        destination = move(x2);
+    }
+
+    /*
+    9_my_ckks.cpp의 (x + 1)^2 * (x^2 + 2)입니다.
+    */
+    void evaluate_quartic(const ScaleManagedEvaluator &evaluator, const Ciphertext &x, Ciphertext &destination)
+    {
+        Ciphertext x2 = x;
+        evaluator.multiply_inplace(x2, x);
+        evaluator.add_const_inplace(x2, 2.0);
+
+        Ciphertext x_plus_one = x;
+        evaluator.add_const_inplace(x_plus_one, 1.0);
+        Ciphertext x_plus_one_sq = x_plus_one;
+        evaluator.multiply_inplace(x_plus_one_sq, x_plus_one);
+
+        evaluator.multiply_inplace(x2, x_plus_one_sq);
+        destination = move(x2);
+    }
+} // namespace
+
+void example_exact_scale()
+{
+    print_example_banner("Example: Exact Scale Management");
+
+    size_t poly_modulus_degree = 16384;
+    for (int bits : { 50, 40, 30 })
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        parms.set_poly_modulus_degree(poly_modulus_degree);
+        parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 60, bits, bits, 60 }));
+        double scale = pow(2.0, bits);
+
+        auto session = SEALSession::Get(parms);
+        const SEALContext &context = session->context();
+        auto &encoder = session->ckks_encoder();
+        auto &decryptor = session->decryptor();
+        session->relin_keys();
+        size_t slot_count = encoder.slot_count();
+
+        print_line(__LINE__);
+        cout << bits << "-bit primes, total coeff_modulus "
+             << context.first_context_data()->total_coeff_modulus_bit_count() << " bits." << endl;
+
+        ScaleManagedEvaluator approximate(*session, ScaleMode::approximate, scale);
+        ScaleManagedEvaluator exact(*session, ScaleMode::exact, scale);
+        for (auto context_data = context.first_context_data(); context_data;
+             context_data = context_data->next_context_data())
+        {
+            size_t level = context_data->chain_index();
+            cout << "    + Level " << level << ": exact scale 2^" << log2(exact.target_scale(level));
+            if (context_data->next_context_data())
+            {
+                double q = static_cast<double>(context_data->parms().coeff_modulus().back().value());
+                cout << ", prime q / 2^" << bits << " - 1 = " << q / scale - 1.0;
+            }
+            cout << endl;
+        }
+
+        vector<double> input(slot_count);
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            input[i] = static_cast<double>(i) / static_cast<double>(slot_count - 1);
+        }
+
+        auto result_error = [&](const Ciphertext &encrypted, const function<double(double)> &reference) {
+            Plaintext plain;
+            decryptor.decrypt(encrypted, plain);
+            vector<double> decoded;
+            encoder.decode(plain, decoded);
+            vector<double> expected(slot_count);
+            for (size_t i = 0; i < slot_count; i++)
+            {
+                expected[i] = reference(input[i]);
+            }
+            return max_abs_error(expected, decoded);
+        };
+        auto cubic = [](double x) { return 3.14159265 * x * x * x + 0.4 * x + 1.0; };
+        auto quartic = [](double x) { return (x + 1.0) * (x + 1.0) * (x * x + 2.0); };
+
+        for (auto *evaluator : { &approximate, &exact })
+        {
+            Ciphertext x, result;
+            evaluator->encrypt(input, x);
+            cout << (evaluator == &exact ? "    + Exact scales:       " : "    + Overwritten scales: ");
+            evaluate_cubic(*evaluator, x, result);
+            cout << "PI*x^3 + 0.4x + 1 max error " << result_error(result, cubic);
+            evaluate_quartic(*evaluator, x, result);
+            cout << ", (x + 1)^2 * (x^2 + 2) max error " << result_error(result, quartic) << endl;
+        }
+    }
+}
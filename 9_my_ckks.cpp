@@ -20,23 +20,21 @@ void example_my_ckks()
 
     double scale = pow(2.0, 50); // 초기 스케일을 설정합니다. 이 예제에서는 2^40으로 설정됩니다.
 
-    SEALContext context(parms); // 암호 컨텍스트를 생성합니다.
+    /*
+    컨텍스트, 키, Evaluator는 세션 레지스트리에서 가져옵니다. 같은 매개변수로 이 예제를 다시 실행하면
+    FFT/NTT 테이블과 키를 새로 만들지 않고 이전 실행에서 만든 것을 그대로 재사용합니다.
+    */
+    auto session = SEALSession::Get(parms); // 암호 컨텍스트를 생성하거나 재사용합니다.
+    const SEALContext &context = session->context();
     print_parameters(context); // 암호화 매개변수를 출력합니다.
     cout << endl;
 
-    KeyGenerator keygen(context); // 암호화 키 생성기를 생성합니다.
-    auto secret_key = keygen.secret_key(); // 비밀 키를 생성합니다.
-    PublicKey public_key;
-    keygen.create_public_key(public_key); // 공개 키를 생성합니다.
-    RelinKeys relin_keys;
-    keygen.create_relin_keys(relin_keys); // 재선형화 키를 생성합니다.
-    GaloisKeys gal_keys;
-    keygen.create_galois_keys(gal_keys); // Galois 키를 생성합니다.
-    Encryptor encryptor(context, public_key); // 암호화 객체를 생성합니다.
-    Evaluator evaluator(context); // 평가자 객체를 생성합니다.
-    Decryptor decryptor(context, secret_key); // 복호화 객체를 생성합니다.
-
-    CKKSEncoder encoder(context); // CKKSEncoder 객체를 생성합니다.
+    auto &relin_keys = session->relin_keys(); // 재선형화 키를 생성합니다.
+    auto &encryptor = session->encryptor(); // 암호화 객체를 생성합니다.
+    auto &evaluator = session->evaluator(); // 평가자 객체를 생성합니다.
+    auto &decryptor = session->decryptor(); // 복호화 객체를 생성합니다.
+
+    auto &encoder = session->ckks_encoder(); // CKKSEncoder 객체를 생성합니다.
     size_t slot_count = encoder.slot_count(); // CKKS 스키마의 슬롯 개수를 가져옵니다. 슬롯은 부동 소수점 값의 저장 공간입니다.
 
     vector<double> input; // 입력 벡터를 저장할 벡터를 생성합니다.
@@ -144,6 +142,15 @@ void example_my_ckks()
     evaluator.relinearize_inplace(encrypted_result, relin_keys);
     evaluator.rescale_to_next_inplace(encrypted_result); // (x + 1)^2 * (x^2 + 2) [level 2]
 
+    /*
+    남은 계산은 복호화와 회전뿐이므로 rescale이 더 필요하지 않습니다. 쓰이지 않는 소수를 버려 암호문을 줄입니다.
+    */
+    print_line(__LINE__);
+    cout << "Finalize (x + 1)^2 * (x^2 + 2)." << endl;
+    FinalizeReport report = finalize_ciphertext(context, evaluator, encrypted_result);
+    cout << "    + Level " << report.from_level << " -> " << report.to_level << ", " << report.bytes_saved()
+         << " bytes saved" << endl;
+
     /*
     먼저 정확한 결과를 출력합니다.
     */
@@ -175,8 +182,7 @@ void example_my_ckks()
     cout << "Example: My Rotation" << endl;
     Ciphertext rotated;
     Plaintext plain;
-    GaloisKeys galois_keys;
-    keygen.create_galois_keys(galois_keys); // Galois 키를 생성합니다.
+    auto &galois_keys = session->galois_keys(); // Galois 키를 생성합니다.
     print_line(__LINE__);
     cout << "Rotate 2 steps left." << endl;
     evaluator.rotate_vector(encrypted_result, 2, galois_keys, rotated); // 암호문 encrypted를 2 단계 왼쪽으로 회전시킵니다.
@@ -26,6 +26,21 @@ int main()
         cout << "| 7. Serialization           | 7_serialization.cpp        |" << endl;
         cout << "| 8. Performance Test        | 8_performance.cpp          |" << endl;
         cout << "| 9. MY CKKS Basics          | 9_my_ckks.cpp              |" << endl;
+        cout << "| 10. Session Registry       | 10_session.cpp             |" << endl;
+        cout << "| 11. Complex Packing        | 11_complex_packing.cpp     |" << endl;
+        cout << "| 12. Convolution Kernels    | 12_convolution.cpp         |" << endl;
+        cout << "| 13. Finalize               | 13_finalize.cpp            |" << endl;
+        cout << "| 14. Sign, Max and ReLU     | 14_comparison.cpp          |" << endl;
+        cout << "| 15. Differential Verify    | 15_differential.cpp        |" << endl;
+        cout << "| 16. Scoped Tracing         | 16_tracing.cpp             |" << endl;
+        cout << "| 17. Batched Inference      | 17_inference.cpp           |" << endl;
+        cout << "| 18. Ciphertext Arena       | 18_arena.cpp               |" << endl;
+        cout << "| 19. Sharded Evaluation     | 19_sharded.cpp             |" << endl;
+        cout << "| 20. Streaming Aggregates   | 20_streaming.cpp           |" << endl;
+        cout << "| 21. PIR Lookup             | 21_pir.cpp                 |" << endl;
+        cout << "| 22. Shared Power Basis     | 22_power_basis.cpp         |" << endl;
+        cout << "| 23. Parallel Key Generation| 23_keygen.cpp              |" << endl;
+        cout << "| 24. Exact Scale Management | 24_exact_scale.cpp         |" << endl;
         cout << "+----------------------------+----------------------------+" << endl;
 
         /*
@@ -42,12 +57,12 @@ int main()
         bool valid = true;
         do
         {
-            cout << endl << "> Run example (1 ~ 9) or exit (0): ";
+            cout << endl << "> Run example (1 ~ 24) or exit (0): ";
             if (!(cin >> selection))
             {
                 valid = false;
             }
-            else if (selection < 0 || selection > 9)
+            else if (selection < 0 || selection > 24)
             {
                 valid = false;
             }
@@ -57,7 +72,7 @@ int main()
             }
             if (!valid)
             {
-                cout << "  [Beep~~] valid option: type 0 ~ 9" << endl;
+                cout << "  [Beep~~] valid option: type 0 ~ 24" << endl;
                 cin.clear();
                 cin.ignore(numeric_limits<streamsize>::max(), '\n');
             }
@@ -99,6 +114,51 @@ int main()
         case 9:
             example_my_ckks();
             break;
+        case 10:
+            example_session();
+            break;
+        case 11:
+            example_complex_packing();
+            break;
+        case 12:
+            example_convolution();
+            break;
+        case 13:
+            example_finalize();
+            break;
+        case 14:
+            example_comparison();
+            break;
+        case 15:
+            example_differential();
+            break;
+        case 16:
+            example_tracing();
+            break;
+        case 17:
+            example_inference();
+            break;
+        case 18:
+            example_arena();
+            break;
+        case 19:
+            example_sharded();
+            break;
+        case 20:
+            example_streaming();
+            break;
+        case 21:
+            example_pir();
+            break;
+        case 22:
+            example_power_basis();
+            break;
+        case 23:
+            example_keygen();
+            break;
+        case 24:
+            example_exact_scale();
+            break;
         case 0:
             return 0;
         }
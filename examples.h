@@ -5,12 +5,15 @@
 
 #include "seal/seal.h"
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <numeric>
@@ -39,6 +42,483 @@ void example_performance_test();
 void example_ckks_basics_h1();
 
 void example_my_ckks();
+
+void example_session();
+
+void example_complex_packing();
+
+void example_convolution();
+
+void example_finalize();
+
+void example_comparison();
+
+void example_differential();
+
+void example_tracing();
+
+void example_inference();
+
+void example_arena();
+
+void example_sharded();
+
+void example_streaming();
+
+void example_pir();
+
+void example_power_basis();
+
+void example_keygen();
+
+void example_exact_scale();
+
+/*
+Helper class: Chrome/Perfetto trace 형식(chrome://tracing, ui.perfetto.dev)으로 구간 이벤트를 모읍니다.
+이벤트는 스레드별 버퍼에 잠금 없이 쌓이고 버퍼가 차거나 스레드가 끝날 때만 잠금을 잡고 모아지며, 추적이 꺼져
+있으면 ScopedTrace는 atomic 플래그 하나만 읽습니다. EventCount()와 WriteChromeTrace()는 호출한 스레드와 끝난
+스레드의 이벤트, 그리고 다른 스레드가 이미 모아 둔 이벤트를 봅니다. SEAL_EXAMPLES_TRACE로 빌드하지 않으면 TRACE_SCOPE는 아무 코드도 만들지 않습니다.
+*/
+class Tracer
+{
+public:
+    static inline bool Enabled() noexcept
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    static void Enable();
+
+    static void Disable();
+
+    static void Clear();
+
+    static std::size_t EventCount();
+
+    static void Record(
+        const char *name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end,
+        long level, std::size_t size);
+
+    /*
+    모은 이벤트를 Chrome trace JSON 파일로 씁니다. 성공하면 true를 돌려줍니다.
+    */
+    static bool WriteChromeTrace(const std::string &path);
+
+private:
+    static inline std::atomic<bool> enabled_{ false };
+};
+
+/*
+Helper class: 생성부터 소멸까지의 구간을 Tracer에 기록합니다. 암호문을 넘기면 연산 직전의 레벨(chain_index)과
+크기(다항식 개수)를 함께 기록합니다.
+*/
+class ScopedTrace
+{
+public:
+    explicit ScopedTrace(const char *name) noexcept
+    {
+        if (Tracer::Enabled())
+        {
+            name_ = name;
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ScopedTrace(const char *name, const seal::SEALContext &context, const seal::Ciphertext &encrypted) noexcept
+        : ScopedTrace(name)
+    {
+        if (name_)
+        {
+            auto context_data = context.get_context_data(encrypted.parms_id());
+            level_ = context_data ? static_cast<long>(context_data->chain_index()) : -1;
+            size_ = encrypted.size();
+        }
+    }
+
+    ScopedTrace(const char *name, const seal::SEALContext &context, const seal::Plaintext &plain) noexcept
+        : ScopedTrace(name)
+    {
+        if (name_)
+        {
+            auto context_data = context.get_context_data(plain.parms_id());
+            level_ = context_data ? static_cast<long>(context_data->chain_index()) : -1;
+            size_ = 1;
+        }
+    }
+
+    ScopedTrace(
+        const char *name, const seal::SEALContext &context, const std::vector<seal::Ciphertext> &encrypteds) noexcept
+        : ScopedTrace(name)
+    {
+        if (name_ && !encrypteds.empty())
+        {
+            auto context_data = context.get_context_data(encrypteds[0].parms_id());
+            level_ = context_data ? static_cast<long>(context_data->chain_index()) : -1;
+            size_ = encrypteds[0].size();
+        }
+    }
+
+    ~ScopedTrace()
+    {
+        if (name_)
+        {
+            Tracer::Record(name_, start_, std::chrono::steady_clock::now(), level_, size_);
+        }
+    }
+
+    ScopedTrace(const ScopedTrace &copy) = delete;
+
+    ScopedTrace &operator=(const ScopedTrace &assign) = delete;
+
+private:
+    const char *name_ = nullptr;
+
+    std::chrono::steady_clock::time_point start_;
+
+    long level_ = -1;
+
+    std::size_t size_ = 0;
+};
+
+#define SEAL_EXAMPLES_TRACE_CONCAT_INNER(a, b) a##b
+#define SEAL_EXAMPLES_TRACE_CONCAT(a, b) SEAL_EXAMPLES_TRACE_CONCAT_INNER(a, b)
+#ifdef SEAL_EXAMPLES_TRACE
+#define TRACE_SCOPE(...) ScopedTrace SEAL_EXAMPLES_TRACE_CONCAT(trace_scope_, __LINE__)(__VA_ARGS__)
+#else
+#define TRACE_SCOPE(...) static_cast<void>(0)
+#endif
+
+/*
+Helper classes: SEAL의 Evaluator, Encryptor, Decryptor, 인코더를 상속하여 각 연산을 TRACE_SCOPE로 감쌉니다.
+SEALSession이 이 클래스들을 돌려주므로 세션을 사용하는 모든 예제의 연산이 추적됩니다. 감싼 함수는 같은 이름의
+기반 클래스 함수에 인자를 그대로 전달하며, SEAL_EXAMPLES_TRACE 없이 빌드하면 전달만 남습니다. 기반 클래스의
+참조(const seal::Evaluator & 등)로 넘기면 추적되지 않습니다.
+*/
+#define SEAL_EXAMPLES_TRACED_OP(base, op)                                               \
+    template <typename T, typename... Args>                                             \
+    inline decltype(auto) op(T &&first, Args &&...args) const                           \
+    {                                                                                   \
+        TRACE_SCOPE(#op, context_, first);                                              \
+        return base::op(std::forward<T>(first), std::forward<Args>(args)...);           \
+    }
+
+class TracedEvaluator : public seal::Evaluator
+{
+public:
+    explicit TracedEvaluator(const seal::SEALContext &context) : seal::Evaluator(context), context_(context)
+    {}
+
+    inline const seal::SEALContext &context() const noexcept
+    {
+        return context_;
+    }
+
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, negate_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, negate)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, add_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, add)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, add_many)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, sub_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, sub)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, multiply_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, multiply)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, multiply_many)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, square_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, square)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, exponentiate_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, exponentiate)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, relinearize_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, relinearize)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, mod_switch_to_next_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, mod_switch_to_next)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, mod_switch_to_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, mod_switch_to)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, rescale_to_next_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, rescale_to_next)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, rescale_to_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, rescale_to)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, add_plain_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, add_plain)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, sub_plain_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, sub_plain)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, multiply_plain_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, multiply_plain)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, transform_to_ntt_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, transform_to_ntt)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, transform_from_ntt_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, transform_from_ntt)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, apply_galois_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, apply_galois)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, rotate_rows_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, rotate_rows)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, rotate_columns_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, rotate_columns)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, rotate_vector_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, rotate_vector)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, complex_conjugate_inplace)
+    SEAL_EXAMPLES_TRACED_OP(seal::Evaluator, complex_conjugate)
+
+private:
+    const seal::SEALContext &context_;
+};
+
+class TracedEncryptor : public seal::Encryptor
+{
+public:
+    TracedEncryptor(const seal::SEALContext &context, const seal::PublicKey &public_key)
+        : seal::Encryptor(context, public_key), context_(context)
+    {}
+
+    inline const seal::SEALContext &context() const noexcept
+    {
+        return context_;
+    }
+
+    SEAL_EXAMPLES_TRACED_OP(seal::Encryptor, encrypt)
+
+private:
+    const seal::SEALContext &context_;
+};
+
+class TracedDecryptor : public seal::Decryptor
+{
+public:
+    TracedDecryptor(const seal::SEALContext &context, const seal::SecretKey &secret_key)
+        : seal::Decryptor(context, secret_key), context_(context)
+    {}
+
+    inline const seal::SEALContext &context() const noexcept
+    {
+        return context_;
+    }
+
+    /*
+    Decryptor::decrypt는 const가 아니므로 매크로 대신 직접 감쌉니다.
+    */
+    inline void decrypt(const seal::Ciphertext &encrypted, seal::Plaintext &destination)
+    {
+        TRACE_SCOPE("decrypt", context_, encrypted);
+        seal::Decryptor::decrypt(encrypted, destination);
+    }
+
+private:
+    const seal::SEALContext &context_;
+};
+
+/*
+인코딩과 디코딩은 암호문이 없으므로 이름만 기록합니다.
+*/
+#define SEAL_EXAMPLES_TRACED_CODEC(base)                                                \
+    template <typename... Args>                                                         \
+    inline decltype(auto) encode(Args &&...args) const                                  \
+    {                                                                                   \
+        TRACE_SCOPE("encode");                                                          \
+        return base::encode(std::forward<Args>(args)...);                               \
+    }                                                                                   \
+                                                                                        \
+    template <typename... Args>                                                         \
+    inline decltype(auto) decode(Args &&...args) const                                  \
+    {                                                                                   \
+        TRACE_SCOPE("decode");                                                          \
+        return base::decode(std::forward<Args>(args)...);                               \
+    }
+
+class TracedCKKSEncoder : public seal::CKKSEncoder
+{
+public:
+    explicit TracedCKKSEncoder(const seal::SEALContext &context) : seal::CKKSEncoder(context)
+    {}
+
+    SEAL_EXAMPLES_TRACED_CODEC(seal::CKKSEncoder)
+};
+
+class TracedBatchEncoder : public seal::BatchEncoder
+{
+public:
+    explicit TracedBatchEncoder(const seal::SEALContext &context) : seal::BatchEncoder(context)
+    {}
+
+    SEAL_EXAMPLES_TRACED_CODEC(seal::BatchEncoder)
+};
+
+/*
+Helper struct: finalize_ciphertext의 결과입니다. 레벨은 modulus switching chain의 chain_index입니다. 크기는 압축하지
+않은 직렬화 크기입니다(기본 압축 모드의 save_size는 실제 크기가 아니라 상한을 돌려줍니다).
+*/
+struct FinalizeReport
+{
+    std::size_t from_level = 0;
+
+    std::size_t to_level = 0;
+
+    std::streamoff bytes_before = 0;
+
+    std::streamoff bytes_after = 0;
+
+    inline std::streamoff bytes_saved() const noexcept
+    {
+        return bytes_before - bytes_after;
+    }
+};
+
+/*
+Helper function: 저장하거나 전송하기 전에 암호문을 유효한 가장 낮은 레벨로 mod switch합니다. remaining_depth는
+이후에 남아 있는 rescale 횟수이며, 그만큼의 레벨은 남겨 둡니다. 또한 그 rescale들이 끝난 레벨의 coeff_modulus가
+현재 스케일보다 headroom_bits 이상 커야 복호화 결과가 넘치지 않으므로 그 조건을 만족하는 레벨에서 멈춥니다.
+*/
+FinalizeReport finalize_ciphertext(
+    const seal::SEALContext &context, const seal::Evaluator &evaluator, seal::Ciphertext &encrypted,
+    std::size_t remaining_depth = 0, int headroom_bits = 10);
+
+/*
+Helper function: 차수 degree인 다항식을 평가하는 데 필요한 곱셈 깊이(rescale 횟수)의 상한을 돌려줍니다. x^degree에
+계수를 마지막에 곱하는 경우의 깊이로 ceil(log2(degree)) + 1입니다. 계수를 낮은 거듭제곱에 먼저 곱하면
+ceil(log2(degree + 1))로 충분합니다(22_power_basis.cpp).
+*/
+inline std::size_t polynomial_depth(std::size_t degree)
+{
+    std::size_t depth = 0;
+    while ((std::size_t(1) << depth) < degree)
+    {
+        depth++;
+    }
+    return degree == 0 ? 0 : depth + 1;
+}
+
+/*
+Helper class: 같은 EncryptionParameters를 사용하는 예제들이 SEALContext, 인코더, Evaluator, 키를
+공유할 수 있도록 프로세스 전역 레지스트리에 보관합니다. 각 구성 요소는 처음 요청될 때 한 번만 생성되며
+(std::call_once), 이후의 호출은 이미 만들어진 객체를 그대로 돌려받습니다. Evaluator, Encryptor, 인코더는
+상태를 갖지 않으므로 여러 스레드에서 동시에 사용해도 안전합니다.
+*/
+class SEALSession
+{
+public:
+    /*
+    parms에 대응하는 세션을 돌려줍니다. 처음 보는 매개변수라면 새 세션을 만들어 등록합니다. SEALContext는
+    레지스트리 잠금 밖에서 만들어지므로 서로 다른 매개변수에 대한 호출은 서로를 기다리지 않습니다.
+    */
+    static std::shared_ptr<SEALSession> Get(const seal::EncryptionParameters &parms);
+
+    /*
+    등록된 모든 세션을 해제합니다. 이미 세션을 들고 있는 호출자는 영향을 받지 않습니다.
+    */
+    static void Clear();
+
+    /*
+    현재 레지스트리에 등록된 세션의 개수를 돌려줍니다. 다른 스레드가 아직 만들고 있는 세션도 포함됩니다.
+    */
+    static std::size_t Count();
+
+    explicit SEALSession(const seal::EncryptionParameters &parms);
+
+    SEALSession(const SEALSession &copy) = delete;
+
+    SEALSession &operator=(const SEALSession &assign) = delete;
+
+    inline const seal::SEALContext &context() const noexcept
+    {
+        return context_;
+    }
+
+    const TracedEvaluator &evaluator();
+
+    const TracedCKKSEncoder &ckks_encoder();
+
+    const TracedBatchEncoder &batch_encoder();
+
+    const seal::SecretKey &secret_key();
+
+    const seal::PublicKey &public_key();
+
+    const seal::RelinKeys &relin_keys();
+
+    const seal::GaloisKeys &galois_keys();
+
+    /*
+    주어진 회전 단계에 대한 Galois 키만 만듭니다. 전체 키 집합은 임의의 단계를 2의 거듭제곱 회전들로 분해하므로
+    회전 한 번에 여러 번의 key switching이 필요하지만, 이 키를 사용하면 각 단계가 key switching 한 번으로
+    끝납니다. 같은 단계 집합에 대한 키는 세션에 캐시됩니다.
+    */
+    const seal::GaloisKeys &galois_keys(std::vector<int> steps);
+
+    const TracedEncryptor &encryptor();
+
+    TracedDecryptor &decryptor();
+
+private:
+    seal::KeyGenerator &keygen();
+
+    seal::SEALContext context_;
+
+    std::once_flag evaluator_flag_;
+    std::unique_ptr<TracedEvaluator> evaluator_;
+
+    std::once_flag ckks_encoder_flag_;
+    std::unique_ptr<TracedCKKSEncoder> ckks_encoder_;
+
+    std::once_flag batch_encoder_flag_;
+    std::unique_ptr<TracedBatchEncoder> batch_encoder_;
+
+    std::once_flag keygen_flag_;
+    std::unique_ptr<seal::KeyGenerator> keygen_;
+
+    std::once_flag public_key_flag_;
+    seal::PublicKey public_key_;
+
+    std::once_flag relin_keys_flag_;
+    seal::RelinKeys relin_keys_;
+
+    std::once_flag galois_keys_flag_;
+    seal::GaloisKeys galois_keys_;
+
+    std::mutex step_galois_keys_mutex_;
+    std::map<std::vector<int>, seal::GaloisKeys> step_galois_keys_;
+
+    std::once_flag encryptor_flag_;
+    std::unique_ptr<TracedEncryptor> encryptor_;
+
+    std::once_flag decryptor_flag_;
+    std::unique_ptr<TracedDecryptor> decryptor_;
+};
+
+/*
+Helper function: uint64_t 하나를 stream에 그대로(호스트 바이트 순서로) 씁니다. MappedFile::read_uint64와 짝을 이룹니다.
+*/
+void write_uint64(std::ostream &stream, std::uint64_t value);
+
+/*
+Helper class: 파일 전체를 읽기 전용으로 mmap합니다(Linux 전용, 구현은 mapped_file.cpp). 매핑은 소멸자에서 해제됩니다.
+*/
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string &path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &copy) = delete;
+
+    MappedFile &operator=(const MappedFile &assign) = delete;
+
+    inline const seal::seal_byte *data() const noexcept
+    {
+        return data_;
+    }
+
+    inline std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    std::uint64_t read_uint64(std::size_t offset) const;
+
+private:
+    const seal::seal_byte *data_ = nullptr;
+
+    std::size_t size_ = 0;
+};
+
 /*
 Helper function: Prints the name of the example in a fancy banner.
 */
@@ -181,6 +661,20 @@ inline void print_vector(std::vector<T> vec, std::size_t print_size = 4, int pre
     std::cout.copyfmt(old_fmt);
 }
 
+/*
+Helper function: 두 벡터의 같은 위치 원소끼리의 차의 절댓값 중 최댓값을 돌려줍니다. computed는 expected보다 짧지
+않아야 합니다(복호화한 슬롯 벡터는 참조 값보다 길 수 있습니다).
+*/
+inline double max_abs_error(const std::vector<double> &expected, const std::vector<double> &computed)
+{
+    double error = 0;
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        error = std::max(error, std::fabs(expected[i] - computed[i]));
+    }
+    return error;
+}
+
 /*
 Helper function: Prints a matrix of values.
 */
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "examples.h"
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace seal;
+
+/*
+19_sharded.cpp와 21_pir.cpp가 함께 쓰는 파일 입출력 도우미입니다.
+*/
+void write_uint64(ostream &stream, uint64_t value)
+{
+    stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+#ifdef __linux__
+MappedFile::MappedFile(const string &path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw runtime_error("cannot open " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        throw runtime_error("cannot stat " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void *data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        throw runtime_error("cannot mmap " + path);
+    }
+    data_ = static_cast<const seal_byte *>(data);
+}
+
+MappedFile::~MappedFile()
+{
+    munmap(const_cast<seal_byte *>(data_), size_);
+}
+
+uint64_t MappedFile::read_uint64(size_t offset) const
+{
+    uint64_t value;
+    memcpy(&value, data_ + offset, sizeof(value));
+    return value;
+}
+#endif